@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "result.h"
+
+namespace {
+
+constexpr std::size_t kHaystackSize = 1000000u;
+
+const std::vector<std::int64_t>& haystack() {
+  static const auto res = [] {
+    std::mt19937 g;
+    std::uniform_int_distribution<std::int64_t> dis(
+        1, static_cast<std::int64_t>(kHaystackSize) * 10);
+
+    std::vector<std::int64_t> res(kHaystackSize);
+    for (auto& x : res) x = dis(g);
+    std::sort(res.begin(), res.end());
+    return res;
+  }();
+
+  return res;
+}
+
+std::vector<std::int64_t> sorted_needles(std::size_t n) {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(
+      1, static_cast<std::int64_t>(kHaystackSize) * 10);
+
+  std::vector<std::int64_t> res(n);
+  for (auto& x : res) x = dis(g);
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+void set_needles_count(benchmark::internal::Benchmark* bench) {
+  for (std::size_t n = 10; n <= kHaystackSize; n *= 10)
+    bench->Arg(static_cast<int>(n));
+}
+
+struct naive_loop {
+  template <typename I, typename J, typename O>
+  O operator()(I f, I l, J needles_f, J needles_l, O out) {
+    for (; needles_f != needles_l; ++needles_f)
+      *out++ = srt::lower_bound_biased(f, l, *needles_f);
+    return out;
+  }
+};
+
+struct std_loop {
+  template <typename I, typename J, typename O>
+  O operator()(I f, I l, J needles_f, J needles_l, O out) {
+    for (; needles_f != needles_l; ++needles_f)
+      *out++ = std::lower_bound(f, l, *needles_f);
+    return out;
+  }
+};
+
+struct biased_batch {
+  template <typename I, typename J, typename O>
+  O operator()(I f, I l, J needles_f, J needles_l, O out) {
+    return srt::lower_bound_biased_batch(f, l, needles_f, needles_l, out);
+  }
+};
+
+}  // namespace
+
+template <typename Searcher>
+void benchmark_batch_search(benchmark::State& state) {
+  const auto& input = haystack();
+  auto needles = sorted_needles(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::vector<std::int64_t>::const_iterator> out(needles.size());
+
+  for (auto _ : state) {
+    Searcher{}(input.begin(), input.end(), needles.begin(), needles.end(),
+               out.begin());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(benchmark_batch_search, std_loop)->Apply(set_needles_count);
+BENCHMARK_TEMPLATE(benchmark_batch_search, naive_loop)->Apply(set_needles_count);
+BENCHMARK_TEMPLATE(benchmark_batch_search, biased_batch)->Apply(set_needles_count);
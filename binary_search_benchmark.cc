@@ -3,10 +3,13 @@
 #include <algorithm>
 #include <cstdint>
 #include <forward_list>
+#include <list>
 #include <random>
 #include <set>
 
+#include "eytzinger_array.h"
 #include "other_algorithms.h"
+#include "static_btree.h"
 
 namespace {
 
@@ -30,6 +33,30 @@ const std::vector<std::int64_t>& ints_test() {
   return res;
 }
 
+// Sizes for the cache effects sweep: 1K, 4K, ... 64M elements.
+constexpr std::size_t kMinProblemSize = 1u << 10;
+constexpr std::size_t kMaxProblemSize = 1u << 26;
+
+// Unique sorted ints, only the last requested size is kept.
+const std::vector<std::int64_t>& ints_test(std::size_t size) {
+  static std::vector<std::int64_t> res;
+  if (res.size() == size) return res;
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(0, 9);
+  res.clear();
+  res.shrink_to_fit();
+  res.resize(size);
+  for (std::size_t i = 0; i != size; ++i)
+    res[i] = static_cast<std::int64_t>(i) * 10 + dis(g);
+  return res;
+}
+
+void set_problem_size(benchmark::internal::Benchmark* bench) {
+  for (std::size_t size = kMinProblemSize; size <= kMaxProblemSize; size *= 4)
+    bench->Arg(static_cast<int>(size));
+}
+
 void set_looking_for_index(benchmark::internal::Benchmark* bench) {
   for (std::size_t looking_for_idx = 0; looking_for_idx < kMaxIdx; looking_for_idx += kStep)
     bench->Arg(static_cast<int>(looking_for_idx));
@@ -70,6 +97,25 @@ struct biased_final {
   }
 };
 
+// Same as biased_final, but hides srt::less so that the simd prefix scan
+// is not used. The int64 kernel needs SSE4.2 or AVX2: configure with
+// -DBENCHMARK_NATIVE_ARCH=ON. Without them both are the same code, and
+// the biased_scalar rows are not registered.
+struct biased_scalar {
+  template <typename I, typename V>
+  I operator()(I f, I l, const V& v) {
+    return srt::lower_bound_biased(
+        f, l, v, [](const auto& x, const auto& y) { return x < y; });
+  }
+};
+
+struct biased_branchless {
+  template <typename I, typename V>
+  I operator()(I f, I l, const V& v) {
+    return srt::lower_bound_biased_branchless(f, l, v);
+  }
+};
+
 struct biased_expensive_cmp {
   template <typename I, typename V>
   I operator()(I f, I l, const V& v) {
@@ -84,6 +130,85 @@ struct using_unsigned {
   }
 };
 
+// Searchers over a whole sorted array, return ranks.
+
+struct sorted_std {
+  const std::vector<std::int64_t>& input;
+
+  explicit sorted_std(const std::vector<std::int64_t>& input) : input(input) {}
+
+  std::size_t operator()(std::int64_t v) const {
+    return static_cast<std::size_t>(
+        std::lower_bound(input.begin(), input.end(), v) - input.begin());
+  }
+
+  std::size_t memory_usage() const {
+    return input.size() * sizeof(std::int64_t);
+  }
+};
+
+struct sorted_biased {
+  const std::vector<std::int64_t>& input;
+
+  explicit sorted_biased(const std::vector<std::int64_t>& input)
+      : input(input) {}
+
+  std::size_t operator()(std::int64_t v) const {
+    return static_cast<std::size_t>(
+        srt::lower_bound_biased(input.begin(), input.end(), v) -
+        input.begin());
+  }
+
+  std::size_t memory_usage() const {
+    return input.size() * sizeof(std::int64_t);
+  }
+};
+
+struct sorted_branchless {
+  const std::vector<std::int64_t>& input;
+
+  explicit sorted_branchless(const std::vector<std::int64_t>& input)
+      : input(input) {}
+
+  std::size_t operator()(std::int64_t v) const {
+    auto n = static_cast<std::ptrdiff_t>(input.size());
+    return static_cast<std::size_t>(
+        srt::partition_point_n_branchless(
+            input.begin(), n, [&](std::int64_t x) { return x < v; }) -
+        input.begin());
+  }
+
+  std::size_t memory_usage() const {
+    return input.size() * sizeof(std::int64_t);
+  }
+};
+
+struct eytzinger {
+  srt::eytzinger_array<std::int64_t> input;
+
+  explicit eytzinger(const std::vector<std::int64_t>& input)
+      : input(input.begin(), input.end()) {}
+
+  std::size_t operator()(std::int64_t v) const {
+    return input.lower_bound(v);
+  }
+
+  std::size_t memory_usage() const { return input.memory_usage(); }
+};
+
+struct static_btree {
+  srt::static_btree<std::int64_t> input;
+
+  explicit static_btree(const std::vector<std::int64_t>& input)
+      : input(input.begin(), input.end()) {}
+
+  std::size_t operator()(std::int64_t v) const {
+    return static_cast<std::size_t>(input.lower_bound(v) - input.begin());
+  }
+
+  std::size_t memory_usage() const { return input.memory_usage(); }
+};
+
 }  // namespace
 
 template <typename Searcher>
@@ -93,12 +218,94 @@ void benchmark_search(benchmark::State& state) {
 
   for (auto _ : state)
     benchmark::DoNotOptimize(Searcher{}(input.begin(), input.end(), looking_for));
+}
+
+// Same as benchmark_search, but over a linked list.
+template <typename List, typename Searcher>
+void benchmark_search_list(benchmark::State& state) {
+  const List input(ints_test().begin(), ints_test().end());
+  auto looking_for = ints_test()[static_cast<std::size_t>(state.range(0))];
 
-#if 0
-  std::forward_list<int> as_list(input.begin(), input.end());
   for (auto _ : state)
-    benchmark::DoNotOptimize(Searcher{}(as_list.begin(), as_list.end(), looking_for));
+    benchmark::DoNotOptimize(Searcher{}(input.begin(), input.end(), looking_for));
+}
+
+// Counted search, the length of a list is usually known.
+template <typename List>
+void benchmark_search_list_n(benchmark::State& state) {
+  const List input(ints_test().begin(), ints_test().end());
+  auto n = static_cast<std::ptrdiff_t>(ints_test().size());
+  auto looking_for = ints_test()[static_cast<std::size_t>(state.range(0))];
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(srt::lower_bound_biased_n(input.begin(), n, looking_for));
+}
+
+// Looks for a random element among the first state.range(0) + 1,
+// so that the branch predictor can't learn the answer.
+template <typename Searcher>
+void benchmark_search_random_up_to(benchmark::State& state) {
+  auto input = ints_test();
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::size_t> dis(
+      0, static_cast<std::size_t>(state.range(0)));
+  std::vector<std::int64_t> looking_for(1u << 16);
+  for (auto& x : looking_for) x = input[dis(g)];
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Searcher{}(input.begin(), input.end(), looking_for[i]));
+    i = (i + 1) % looking_for.size();
+  }
+}
+
+BENCHMARK_TEMPLATE(benchmark_search, using_unsigned)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_random_up_to, biased_final)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_random_up_to, biased_branchless)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search, biased_final)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search, biased_branchless)->Apply(set_looking_for_index);
+#if defined(__AVX2__) || defined(__SSE4_2__)
+BENCHMARK_TEMPLATE(benchmark_search, biased_scalar)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_random_up_to, biased_scalar)->Apply(set_looking_for_index);
 #endif
+using forward_list_t = std::forward_list<std::int64_t>;
+using list_t = std::list<std::int64_t>;
+
+BENCHMARK_TEMPLATE(benchmark_search_list, forward_list_t, linear)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list, forward_list_t, binary)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list, forward_list_t, biased_expensive_cmp)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list, forward_list_t, biased_final)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list_n, forward_list_t)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list, list_t, linear)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list, list_t, binary)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list, list_t, biased_expensive_cmp)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list, list_t, biased_final)->Apply(set_looking_for_index);
+BENCHMARK_TEMPLATE(benchmark_search_list_n, list_t)->Apply(set_looking_for_index);
+
+// Random lookups over the whole array of state.range(0) elements.
+template <typename Searcher>
+void benchmark_search_problem_size(benchmark::State& state) {
+  const auto& input = ints_test(static_cast<std::size_t>(state.range(0)));
+  const Searcher searcher(input);
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(0, input.back());
+  std::vector<std::int64_t> looking_for(1u << 16);
+  for (auto& x : looking_for) x = dis(g);
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(searcher(looking_for[i]));
+    i = (i + 1) % looking_for.size();
+  }
+
+  state.counters["bytes"] = static_cast<double>(searcher.memory_usage());
 }
 
-BENCHMARK_TEMPLATE(benchmark_search, using_unsigned)->Apply(set_looking_for_index);
\ No newline at end of file
+BENCHMARK_TEMPLATE(benchmark_search_problem_size, sorted_std)->Apply(set_problem_size);
+BENCHMARK_TEMPLATE(benchmark_search_problem_size, sorted_branchless)->Apply(set_problem_size);
+BENCHMARK_TEMPLATE(benchmark_search_problem_size, eytzinger)->Apply(set_problem_size);
+BENCHMARK_TEMPLATE(benchmark_search_problem_size, static_btree)->Apply(set_problem_size);
+BENCHMARK_TEMPLATE(benchmark_search_problem_size, sorted_biased)->Apply(set_problem_size);
@@ -7,13 +7,25 @@
 
 #include "other_algorithms.h"
 
+// Counts both "less" and three-way calls.
+struct counting_compare {
+  int* calls;
+
+  bool operator()(int x, int y) {
+    ++*calls;
+    return x < y;
+  }
+
+  int three_way(int x, int y) {
+    ++*calls;
+    return x < y ? -1 : x > y;
+  }
+};
+
 template <typename I, typename Alg>
 int count_compare_invocations(I f, I l, int pos, Alg alg) {
   int res = 0;
-  alg(f, l, f[pos], [&](int x, int y) mutable {
-    ++res;
-    return x < y;
-  });
+  alg(f, l, f[pos], counting_compare{&res});
   return res;
 }
 
@@ -56,7 +68,74 @@ struct biased_expensive_cmp {
   std::string name() const { return "biased_expensive_cmp"; }
 };
 
-int main() {
+struct equal_range_n_two_way {
+  template <typename I, typename V>
+  auto operator()(I f, I l, const V& v, counting_compare p) {
+    return srt::equal_range_n(f, l - f, v, p);
+  }
+
+  std::string name() const { return "equal_range_n_two_way"; }
+};
+
+struct equal_range_n_three_way {
+  template <typename I, typename V>
+  auto operator()(I f, I l, const V& v, counting_compare p) {
+    return srt::equal_range_n(
+        f, l - f, v,
+        srt::three_way([p](int x, int y) mutable { return p.three_way(x, y); }));
+  }
+
+  std::string name() const { return "equal_range_n_three_way"; }
+};
+
+struct equal_range_biased_two_way {
+  template <typename I, typename V>
+  auto operator()(I f, I l, const V& v, counting_compare p) {
+    return srt::equal_range_biased(f, l, v, p);
+  }
+
+  std::string name() const { return "equal_range_biased_two_way"; }
+};
+
+struct equal_range_biased_three_way {
+  template <typename I, typename V>
+  auto operator()(I f, I l, const V& v, counting_compare p) {
+    return srt::equal_range_biased(
+        f, l, v,
+        srt::three_way([p](int x, int y) mutable { return p.three_way(x, y); }));
+  }
+
+  std::string name() const { return "equal_range_biased_three_way"; }
+};
+
+template <typename I, typename Alg>
+void output_for_all_positions(I f, I l, Alg alg) {
+  std::cout << "{\n\"benchmarks\": [\n";
+  for (int i = 0; i < static_cast<int>(l - f); ++i) {
+    if (i != 0) std::cout << ",\n";
+    mimicking_gbench_output(f, l, i, alg);
+  }
+  std::cout << "]}" << std::endl;
+}
+
+template <typename I>
+bool output_if_selected(I, I, const std::string&) {
+  return false;
+}
+
+template <typename I, typename Alg, typename... Algs>
+bool output_if_selected(I f, I l, const std::string& selected, Alg alg,
+                        Algs... algs) {
+  if (alg.name() == selected) {
+    output_for_all_positions(f, l, alg);
+    return true;
+  }
+  return output_if_selected(f, l, selected, algs...);
+}
+
+// Usage: predicate_invocation_count [algorithm name], one chart line per
+// run. The equal_range pairs show what three-way comparisons save.
+int main(int argc, char** argv) {
   constexpr std::size_t kProblemSize = 1000u;
 
   std::mt19937 g;
@@ -70,10 +149,13 @@ int main() {
   std::vector<std::int64_t> v(unique_sorted_ints.begin(),
                               unique_sorted_ints.end());
 
-  std::cout << "{\n\"benchmarks\": [\n";
-  for (int i = 0; i < static_cast<int>(kProblemSize); ++i) {
-    if (i != 0) std::cout << ",\n";
-    mimicking_gbench_output(&v[0], &v[0] + v.size(), i, biased_expensive_cmp{});
+  std::string selected = argc > 1 ? argv[1] : "biased_expensive_cmp";
+  if (!output_if_selected(&v[0], &v[0] + v.size(), selected, binary{},
+                          biased_final{}, biased_expensive_cmp{},
+                          equal_range_n_two_way{}, equal_range_n_three_way{},
+                          equal_range_biased_two_way{},
+                          equal_range_biased_three_way{})) {
+    std::cerr << "unknown algorithm: " << selected << std::endl;
+    return 1;
   }
-  std::cout << "]}" << std::endl;
 }
@@ -46,6 +46,90 @@ def generateMapOfStyles():
         line = dict(width = 3, dash = 'solid', color = 'rgb(000, 153, 076)')
     )
 
+    styles['benchmark_search<biased_branchless>'] = dict(
+        mode = 'lines',
+        name = 'biased_branchless',
+        line = dict(width = 3, dash = 'dot', color = 'rgb(000, 076, 153)')
+    )
+
+    styles['benchmark_search_random_up_to<biased_final>'] = dict(
+        mode = 'lines',
+        name = 'biased_final (random)',
+        line = dict(width = 3, dash = 'solid', color = 'rgb(000, 153, 076)')
+    )
+
+    styles['benchmark_search_random_up_to<biased_branchless>'] = dict(
+        mode = 'lines',
+        name = 'biased_branchless (random)',
+        line = dict(width = 3, dash = 'dot', color = 'rgb(000, 076, 153)')
+    )
+
+    styles['benchmark_search<biased_scalar>'] = dict(
+        mode = 'lines',
+        name = 'biased_scalar',
+        line = dict(width = 3, dash = 'dash', color = 'rgb(153, 076, 000)')
+    )
+
+    styles['benchmark_search_random_up_to<biased_scalar>'] = dict(
+        mode = 'lines',
+        name = 'biased_scalar (random)',
+        line = dict(width = 3, dash = 'dash', color = 'rgb(153, 076, 000)')
+    )
+
+    styles['benchmark_search_problem_size<sorted_std>'] = dict(
+        mode = 'lines',
+        name = 'std::lower_bound (size sweep)',
+        line = dict(width = 3, dash = 'dot', color = 'rgb(100, 000, 100)')
+    )
+
+    styles['benchmark_search_problem_size<sorted_branchless>'] = dict(
+        mode = 'lines',
+        name = 'partition_point_n_branchless (size sweep)',
+        line = dict(width = 3, dash = 'dot', color = 'rgb(000, 076, 153)')
+    )
+
+    styles['benchmark_search_problem_size<eytzinger>'] = dict(
+        mode = 'lines',
+        name = 'eytzinger (size sweep)',
+        line = dict(width = 3, dash = 'solid', color = 'rgb(204, 102, 000)')
+    )
+
+    styles['benchmark_search_problem_size<static_btree>'] = dict(
+        mode = 'lines',
+        name = 'static_btree (size sweep)',
+        line = dict(width = 3, dash = 'solid', color = 'rgb(102, 000, 204)')
+    )
+
+    styles['benchmark_search_problem_size<sorted_biased>'] = dict(
+        mode = 'lines',
+        name = 'biased_final (size sweep)',
+        line = dict(width = 3, dash = 'solid', color = 'rgb(000, 153, 076)')
+    )
+
+    styles['benchmark_search<equal_range_n_two_way>'] = dict(
+        mode = 'lines',
+        name = 'equal_range_n',
+        line = dict(width = 3, dash = 'dash', color = 'rgb(000, 102, 204)')
+    )
+
+    styles['benchmark_search<equal_range_n_three_way>'] = dict(
+        mode = 'lines',
+        name = 'equal_range_n (three-way)',
+        line = dict(width = 3, dash = 'solid', color = 'rgb(000, 102, 204)')
+    )
+
+    styles['benchmark_search<equal_range_biased_two_way>'] = dict(
+        mode = 'lines',
+        name = 'equal_range_biased',
+        line = dict(width = 3, dash = 'dash', color = 'rgb(000, 153, 076)')
+    )
+
+    styles['benchmark_search<equal_range_biased_three_way>'] = dict(
+        mode = 'lines',
+        name = 'equal_range_biased (three-way)',
+        line = dict(width = 3, dash = 'solid', color = 'rgb(000, 153, 076)')
+    )
+
     return styles
 
 class parsedBenchmark:
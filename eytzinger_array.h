@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+
+namespace srt {
+
+// A read only sorted array stored in BFS order of the implicit binary
+// search tree (Eytzinger layout): the root is at 1, children of k are
+// at 2k and 2k + 1. The first few levels of the tree, which every search
+// goes through, share a handful of cache lines and the children of a
+// node are next to each other, so the next levels can be prefetched.
+//
+// Searches return ranks: positions in the original sorted order.
+
+template <typename T>
+class eytzinger_array {
+  static constexpr std::size_t kCacheLine = 64;
+  // Descendants of k, log2(kBlock) levels down, are
+  // [k * kBlock, (k + 1) * kBlock) and share a cache line.
+  static constexpr std::size_t kBlock =
+      sizeof(T) < kCacheLine ? kCacheLine / sizeof(T) : 1;
+
+  std::vector<T> storage_;
+  // storage_[offset_] is the first element that starts at or after a
+  // cache line boundary. Best effort: it is on the boundary only if the
+  // distance to it is a multiple of sizeof(T).
+  std::size_t offset_ = 0;
+  std::size_t size_ = 0;
+  std::size_t depth_ = 0;   // of the last level, root is 0.
+
+  static std::size_t aligned_offset(const T* p) {
+    auto addr = reinterpret_cast<std::uintptr_t>(p);
+    std::size_t bytes = (kCacheLine - addr % kCacheLine) % kCacheLine;
+    return (bytes + sizeof(T) - 1) / sizeof(T);
+  }
+
+  const T* tree() const { return storage_.data() + offset_; }
+  T* tree() { return storage_.data() + offset_; }
+
+  template <typename I>
+  // requires ForwardIterator<I>
+  I fill(I f, std::size_t k) {
+    if (k > size_) return f;
+    f = fill(f, 2 * k);
+    tree()[k] = *f;
+    ++f;
+    return fill(f, 2 * k + 1);
+  }
+
+  template <typename Fn>
+  void for_each_in_order(std::size_t k, Fn& fn) const {
+    if (k > size_) return;
+    for_each_in_order(2 * k, fn);
+    fn(tree()[k]);
+    for_each_in_order(2 * k + 1, fn);
+  }
+
+  static std::size_t log2(std::size_t x) {
+    return static_cast<std::size_t>(63 - __builtin_clzll(x));
+  }
+
+  // In order position of the tree node k, k == 0 means "none".
+  std::size_t rank(std::size_t k) const {
+    if (k == 0) return size_;
+    std::size_t d = log2(k);
+    std::size_t perfect =
+        ((2 * (k - (std::size_t{1} << d)) + 1) << (depth_ - d)) - 1;
+    // The missing leaves of the last level would be at every other
+    // position from 2 * existing_leaves on.
+    std::size_t leaves = 2 * (size_ - ((std::size_t{1} << depth_) - 1));
+    return perfect - (perfect > leaves ? (perfect - leaves + 1) / 2 : 0);
+  }
+
+  template <typename P>
+  std::size_t partition_point_index(P p) const {
+    const T* t = tree();
+    std::size_t k = 1;
+    while (k <= size_) {
+      __builtin_prefetch(t + k * kBlock);
+      k = 2 * k + static_cast<std::size_t>(p(t[k]));
+    }
+    // Strip the trailing right turns and the last left one.
+    return k >> __builtin_ffsll(static_cast<long long>(~k));
+  }
+
+ public:
+  using value_type = T;
+
+  eytzinger_array() = default;
+
+  // [f, l) is sorted.
+  template <typename I>
+  // requires ForwardIterator<I> && ValueType<I> == T
+  eytzinger_array(I f, I l)
+      : size_(static_cast<std::size_t>(std::distance(f, l))) {
+    // aligned_offset is at most kCacheLine / sizeof(T) + 1.
+    storage_.resize(size_ + 1 + kCacheLine / sizeof(T) + 1);
+    offset_ = aligned_offset(storage_.data());
+    depth_ = size_ == 0 ? 0 : log2(size_);
+    fill(f, 1);
+  }
+
+  eytzinger_array(const eytzinger_array& x)
+      : size_(x.size_), depth_(x.depth_) {
+    storage_.resize(x.storage_.size());
+    offset_ = aligned_offset(storage_.data());
+    std::copy(x.tree(), x.tree() + size_ + 1, tree());
+  }
+
+  eytzinger_array(eytzinger_array&&) = default;
+
+  eytzinger_array& operator=(eytzinger_array x) {
+    storage_ = std::move(x.storage_);
+    offset_ = x.offset_;
+    size_ = x.size_;
+    depth_ = x.depth_;
+    return *this;
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Elements in sorted order.
+  std::vector<T> to_sorted() const {
+    std::vector<T> res;
+    res.reserve(size_);
+    auto push = [&](const T& x) { res.push_back(x); };
+    for_each_in_order(1, push);
+    return res;
+  }
+
+  std::size_t memory_usage() const {
+    return sizeof(*this) + storage_.capacity() * sizeof(T);
+  }
+
+  template <typename V, typename P>
+  // requires StrictWeakOrder<P(T, V)>
+  std::size_t lower_bound(const V& v, P p) const {
+    return rank(partition_point_index([&](const T& x) { return p(x, v); }));
+  }
+
+  template <typename V>
+  // requires WeakComarable<T, V>
+  std::size_t lower_bound(const V& v) const {
+    return lower_bound(v, less{});
+  }
+
+  template <typename V, typename P>
+  // requires StrictWeakOrder<P(T, V)>
+  std::size_t upper_bound(const V& v, P p) const {
+    return rank(partition_point_index([&](const T& x) { return !p(v, x); }));
+  }
+
+  template <typename V>
+  // requires WeakComarable<T, V>
+  std::size_t upper_bound(const V& v) const {
+    return upper_bound(v, less{});
+  }
+
+  template <typename V, typename P>
+  // requires StrictWeakOrder<P(T, V)>
+  std::pair<std::size_t, std::size_t> equal_range(const V& v, P p) const {
+    return {lower_bound(v, p), upper_bound(v, p)};
+  }
+
+  template <typename V>
+  // requires WeakComarable<T, V>
+  std::pair<std::size_t, std::size_t> equal_range(const V& v) const {
+    return equal_range(v, less{});
+  }
+
+  template <typename V>
+  // requires WeakComarable<T, V>
+  bool contains(const V& v) const {
+    std::size_t k = partition_point_index([&](const T& x) { return x < v; });
+    return k != 0 && !(v < tree()[k]);
+  }
+};
+
+}  // namespace srt
@@ -0,0 +1,68 @@
+#include "eytzinger_array.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("eytzinger_array", "[eytzinger]") {
+  std::mt19937 g;
+
+  for (int size = 0; size < 150; ++size) {
+    std::uniform_int_distribution<int> dis(0, size);
+    std::vector<int> sorted(static_cast<std::size_t>(size));
+    for (int& x : sorted) x = dis(g);
+    std::sort(sorted.begin(), sorted.end());
+
+    srt::eytzinger_array<int> e(sorted.begin(), sorted.end());
+    REQUIRE(e.size() == sorted.size());
+    REQUIRE(e.to_sorted() == sorted);
+
+    srt::eytzinger_array<int> copy = e;
+    REQUIRE(copy.to_sorted() == sorted);
+
+    for (int v = -1; v <= size + 1; ++v) {
+      auto lb = static_cast<std::size_t>(
+          std::lower_bound(sorted.begin(), sorted.end(), v) - sorted.begin());
+      auto ub = static_cast<std::size_t>(
+          std::upper_bound(sorted.begin(), sorted.end(), v) - sorted.begin());
+
+      REQUIRE(e.lower_bound(v) == lb);
+      REQUIRE(e.upper_bound(v) == ub);
+      REQUIRE(e.equal_range(v) == std::make_pair(lb, ub));
+      REQUIRE(e.contains(v) == (lb != ub));
+      REQUIRE(copy.lower_bound(v) == lb);
+    }
+  }
+}
+
+TEST_CASE("eytzinger_array_custom_compare", "[eytzinger]") {
+  std::vector<std::string> sorted{"d", "c", "b", "b", "a"};
+  srt::eytzinger_array<std::string> e(sorted.begin(), sorted.end());
+  auto greater = [](const std::string& x, const std::string& y) { return x > y; };
+
+  REQUIRE(e.lower_bound(std::string("b"), greater) == 2);
+  REQUIRE(e.upper_bound(std::string("b"), greater) == 4);
+  REQUIRE(e.lower_bound(std::string("z"), greater) == 0);
+  REQUIRE(e.upper_bound(std::string("0"), greater) == 5);
+}
+
+TEST_CASE("eytzinger_array_element_size", "[eytzinger]") {
+  // 24 bytes: the cache line boundary is usually not an element boundary.
+  using T = std::array<std::int64_t, 3>;
+
+  for (std::int64_t size = 0; size < 100; ++size) {
+    std::vector<T> sorted;
+    for (std::int64_t i = 0; i != size; ++i) sorted.push_back({i, i, i});
+
+    srt::eytzinger_array<T> e(sorted.begin(), sorted.end());
+    srt::eytzinger_array<T> copy = e;
+    REQUIRE(e.to_sorted() == sorted);
+    REQUIRE(copy.to_sorted() == sorted);
+    for (std::int64_t v = 0; v <= size; ++v)
+      REQUIRE(copy.lower_bound(T{v, v, v}) == static_cast<std::size_t>(v));
+  }
+}
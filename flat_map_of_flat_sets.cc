@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <random>
@@ -7,30 +8,11 @@
 #include <iostream>
 
 #include "third_party/catch.h"
-#include "result.h"
-#include <boost/container/flat_set.hpp>
-#include <boost/container/flat_map.hpp>
+#include "flat_map_of_flat_sets.h"
 
 using boost::container::flat_map;
 using boost::container::flat_set;
 
-template <typename K, typename V>
-flat_map<K, flat_set<V>> build_flat_map_of_flat_sets(std::vector<std::pair<K, V>> buf) {
-  std::sort(buf.begin(), buf.end());
-  buf.erase(std::unique(buf.begin(), buf.end()), buf.end());
-
-  flat_map<K, flat_set<V>> res;
-  for (auto r : srt::group_equals(buf.begin(), buf.end(),
-                                  [](const auto& x, const auto& y) { return x.first < y.first; })) {
-    res.emplace_hint(res.end(), std::move(r.begin()->first), flat_set<V>{});
-    auto& cur_set = (--res.end())->second;
-    for (auto& elem : r)
-      cur_set.insert(cur_set.end(), std::move(elem.second));
-  }
-
-  return res;
-}
-
 template <typename C>
 std::vector<std::pair<int, int>> to_vector_of_pairs_for_test(const C& c) {
   std::vector<std::pair<int, int>> res;
@@ -70,3 +52,57 @@ TEST_CASE("build_flat_map_of_flat_sets", "[usage_examples]") {
       REQUIRE(expected_vec == actual_vec);
     }
 }
+
+TEST_CASE("build_flat_multimap_csr", "[usage_examples]") {
+  std::uniform_int_distribution<> dist(0, 100);
+  std::mt19937 g;
+
+  for (int size : {0, 1, 10, 100, 1000}) {
+    std::vector<std::pair<int, int>> input;
+    for (int i = 0; i < size; ++i) input.emplace_back(dist(g), dist(g));
+
+    auto nested = build_flat_map_of_flat_sets(input);
+    auto csr = build_flat_multimap_csr(input);
+
+    REQUIRE(csr.size() == nested.size());
+
+    std::vector<std::pair<int, int>> csr_vec;
+    for (std::size_t i = 0; i != csr.size(); ++i)
+      for (int v : csr.values_at(i)) csr_vec.emplace_back(csr.keys()[i], v);
+    REQUIRE(csr_vec == to_vector_of_pairs_for_test(nested));
+
+    for (int k = -1; k <= 101; ++k) {
+      auto it = nested.find(k);
+      auto r = csr.values(k);
+      if (it == nested.end()) {
+        REQUIRE(r.begin() == r.end());
+        continue;
+      }
+      REQUIRE(std::vector<int>(r.begin(), r.end()) ==
+              std::vector<int>(it->second.begin(), it->second.end()));
+      for (int v = -1; v <= 101; ++v)
+        REQUIRE(csr.contains(k, v) == (it->second.count(v) != 0));
+    }
+  }
+}
+
+TEST_CASE("build_flat_map_of_flat_sets_parallel", "[usage_examples]") {
+  std::mt19937 g;
+
+  for (int max_key : {0, 3, 100}) {
+    std::uniform_int_distribution<> keys(0, max_key);
+    std::uniform_int_distribution<> values(0, 100);
+
+    for (int size : {0, 1, 10, 100, 1000, 10000}) {
+      std::vector<std::pair<int, int>> input;
+      for (int i = 0; i < size; ++i) input.emplace_back(keys(g), values(g));
+
+      auto expected = to_vector_of_pairs_for_test(build_flat_map_of_flat_sets(input));
+
+      for (std::size_t threads : {1u, 2u, 3u, 4u, 8u}) {
+        auto actual = build_flat_map_of_flat_sets_parallel(input, threads);
+        REQUIRE(to_vector_of_pairs_for_test(actual) == expected);
+      }
+    }
+  }
+}
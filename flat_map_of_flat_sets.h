@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+
+#include "flat_multimap_csr.h"
+#include "parallel_algorithms.h"
+#include "result.h"
+
+template <typename K, typename V>
+boost::container::flat_map<K, boost::container::flat_set<V>>
+build_flat_map_of_flat_sets(std::vector<std::pair<K, V>> buf) {
+  srt::sort_adaptive(buf.begin(), buf.end());
+  buf.erase(srt::unique_biased(buf.begin(), buf.end()), buf.end());
+
+  boost::container::flat_map<K, boost::container::flat_set<V>> res;
+  for (auto r : srt::group_equals(buf.begin(), buf.end(),
+                                  [](const auto& x, const auto& y) { return x.first < y.first; })) {
+    res.emplace_hint(res.end(), std::move(r.begin()->first), boost::container::flat_set<V>{});
+    auto& cur_set = (--res.end())->second;
+    for (auto& elem : r)
+      cur_set.insert(cur_set.end(), std::move(elem.second));
+  }
+
+  return res;
+}
+
+template <typename K, typename V>
+srt::flat_multimap_csr<K, V> build_flat_multimap_csr(std::vector<std::pair<K, V>> buf) {
+  srt::sort_adaptive(buf.begin(), buf.end());
+  buf.erase(srt::unique_biased(buf.begin(), buf.end()), buf.end());
+  return {buf.begin(), buf.end()};
+}
+
+// Same as build_flat_map_of_flat_sets but on `threads` threads. After
+// the sort, the buffer is split at key boundaries, so every chunk can
+// be deduplicated and grouped on its own and the results just
+// concatenated.
+template <typename K, typename V>
+boost::container::flat_map<K, boost::container::flat_set<V>>
+build_flat_map_of_flat_sets_parallel(std::vector<std::pair<K, V>> buf,
+                                     std::size_t threads) {
+  using map_type = boost::container::flat_map<K, boost::container::flat_set<V>>;
+  using sequence_type = typename map_type::sequence_type;
+
+  srt::parallel_sort_adaptive(buf.begin(), buf.end(), srt::less{}, threads);
+
+  auto by_key = [](const auto& x, const auto& y) { return x.first < y.first; };
+  auto bounds = srt::split_at_group_boundaries(buf.begin(), buf.end(), by_key, threads);
+
+  std::vector<sequence_type> parts(bounds.size() - 1);
+  srt::run_in_parallel(parts.size(), [&](std::size_t i) {
+    auto f = bounds[i];
+    auto l = srt::unique_biased(f, bounds[i + 1]);
+    for (auto r : srt::group_equals(f, l, by_key)) {
+      parts[i].emplace_back(std::move(r.begin()->first), boost::container::flat_set<V>{});
+      auto& cur_set = parts[i].back().second;
+      for (auto& elem : r)
+        cur_set.insert(cur_set.end(), std::move(elem.second));
+    }
+  });
+
+  std::size_t total = 0;
+  for (const auto& part : parts) total += part.size();
+
+  sequence_type seq;
+  seq.reserve(total);
+  for (auto& part : parts)
+    std::move(part.begin(), part.end(), std::back_inserter(seq));
+
+  map_type res;
+  res.adopt_sequence(boost::container::ordered_unique_range, std::move(seq));
+  return res;
+}
@@ -0,0 +1,213 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "flat_map_of_flat_sets.h"
+#include "flat_set_algorithms.h"
+
+using boost::container::flat_map;
+using boost::container::flat_set;
+
+namespace {
+
+constexpr std::size_t kPairsCount = 1000000u;
+constexpr std::size_t kQueriesCount = 1u << 16;
+constexpr std::size_t kParallelPairsCount = 10000000u;
+constexpr std::size_t kSetSize = 1u << 20;
+
+using pairs_t = std::vector<std::pair<std::int32_t, std::int32_t>>;
+
+// Key space is chosen so that every key has ~values_per_key values.
+pairs_t random_pairs(std::size_t values_per_key,
+                     std::size_t size = kPairsCount) {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int32_t> keys(
+      0, static_cast<std::int32_t>(size / values_per_key));
+  std::uniform_int_distribution<std::int32_t> values(0, 1000000);
+
+  pairs_t res(size);
+  for (auto& pr : res) pr = {keys(g), values(g)};
+  return res;
+}
+
+void set_values_per_key(benchmark::internal::Benchmark* bench) {
+  for (std::size_t n = 1; n <= 10000; n *= 10)
+    bench->Arg(static_cast<int>(n));
+}
+
+// 1, 2, 4, ... up to the number of cores.
+void set_threads_count(benchmark::internal::Benchmark* bench) {
+  std::size_t cores = srt::default_thread_count();
+  for (std::size_t n = 1; n < cores; n *= 2) bench->Arg(static_cast<int>(n));
+  bench->Arg(static_cast<int>(cores));
+}
+
+// Heap usage without allocator overhead, which is per allocation and so
+// makes the nested version look even worse.
+template <typename K, typename V>
+std::size_t memory_usage(const flat_map<K, flat_set<V>>& m) {
+  std::size_t res = sizeof(m) + m.capacity() * sizeof(*m.begin());
+  for (const auto& pr : m) res += pr.second.capacity() * sizeof(V);
+  return res;
+}
+
+template <typename K, typename V>
+std::size_t memory_usage(const srt::flat_multimap_csr<K, V>& m) {
+  return m.memory_usage();
+}
+
+template <typename K, typename V>
+bool contains(const flat_map<K, flat_set<V>>& m, const K& k, const V& v) {
+  auto it = m.find(k);
+  return it != m.end() && it->second.count(v) != 0;
+}
+
+template <typename K, typename V>
+bool contains(const srt::flat_multimap_csr<K, V>& m, const K& k, const V& v) {
+  return m.contains(k, v);
+}
+
+// Sorted and unique.
+std::vector<std::int32_t> random_sorted_values(std::size_t size,
+                                               std::uint32_t seed) {
+  std::mt19937 g(seed);
+  std::uniform_int_distribution<std::int32_t> values(0, 1 << 30);
+  std::vector<std::int32_t> res(size);
+  for (auto& x : res) x = values(g);
+  std::sort(res.begin(), res.end());
+  res.erase(std::unique(res.begin(), res.end()), res.end());
+  return res;
+}
+
+void set_delta_percent(benchmark::internal::Benchmark* bench) {
+  for (int percent : {1, 5, 25, 100}) bench->Arg(percent);
+}
+
+struct one_by_one {
+  template <typename I>
+  void operator()(flat_set<std::int32_t>& s, I f, I l) {
+    for (; f != l; ++f) s.insert(*f);
+  }
+};
+
+struct boost_ordered_range {
+  template <typename I>
+  void operator()(flat_set<std::int32_t>& s, I f, I l) {
+    s.insert(boost::container::ordered_unique_range, f, l);
+  }
+};
+
+struct insert_sorted_range {
+  template <typename I>
+  void operator()(flat_set<std::int32_t>& s, I f, I l) {
+    srt::insert_sorted_range(s, f, l);
+  }
+};
+
+struct nested {
+  auto operator()(pairs_t buf) {
+    return build_flat_map_of_flat_sets(std::move(buf));
+  }
+};
+
+struct csr {
+  auto operator()(pairs_t buf) { return build_flat_multimap_csr(std::move(buf)); }
+};
+
+struct nested_parallel {
+  std::size_t threads;
+
+  auto operator()(pairs_t buf) {
+    return build_flat_map_of_flat_sets_parallel(std::move(buf), threads);
+  }
+};
+
+}  // namespace
+
+template <typename Builder>
+void benchmark_build(benchmark::State& state) {
+  auto input = random_pairs(static_cast<std::size_t>(state.range(0)));
+  std::size_t bytes = 0;
+
+  for (auto _ : state) {
+    auto m = Builder{}(input);
+    bytes = memory_usage(m);
+    benchmark::DoNotOptimize(m);
+  }
+
+  state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+// Half of the queries are for pairs that are present.
+template <typename Builder>
+void benchmark_lookup(benchmark::State& state) {
+  auto input = random_pairs(static_cast<std::size_t>(state.range(0)));
+  auto m = Builder{}(input);
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::size_t> dis(0, input.size() - 1);
+  pairs_t queries(kQueriesCount);
+  for (std::size_t i = 0; i != queries.size(); ++i) {
+    queries[i] = input[dis(g)];
+    queries[i].second += static_cast<std::int32_t>(i % 2);
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(contains(m, queries[i].first, queries[i].second));
+    i = (i + 1) % queries.size();
+  }
+
+  state.counters["bytes"] = static_cast<double>(memory_usage(m));
+}
+
+// 10 values per key.
+void benchmark_build_parallel(benchmark::State& state) {
+  static const auto input = random_pairs(10, kParallelPairsCount);
+  nested_parallel builder{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state) {
+    auto m = builder(input);
+    benchmark::DoNotOptimize(m);
+  }
+
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(input.size()));
+}
+
+template <typename Inserter>
+void benchmark_insert_sorted_range(benchmark::State& state) {
+  const auto values = random_sorted_values(kSetSize, 0);
+  const flat_set<std::int32_t> base(boost::container::ordered_unique_range,
+                                    values.begin(), values.end());
+  const auto delta = random_sorted_values(
+      kSetSize * static_cast<std::size_t>(state.range(0)) / 100, 1);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto s = base;
+    state.ResumeTiming();
+
+    Inserter{}(s, delta.begin(), delta.end());
+    benchmark::DoNotOptimize(s);
+  }
+}
+
+BENCHMARK_TEMPLATE(benchmark_build, nested)->Apply(set_values_per_key);
+BENCHMARK_TEMPLATE(benchmark_build, csr)->Apply(set_values_per_key);
+BENCHMARK_TEMPLATE(benchmark_lookup, nested)->Apply(set_values_per_key);
+BENCHMARK_TEMPLATE(benchmark_lookup, csr)->Apply(set_values_per_key);
+BENCHMARK(benchmark_build_parallel)
+    ->Apply(set_threads_count)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+// One by one only for the smallest delta: the rest take seconds.
+BENCHMARK_TEMPLATE(benchmark_insert_sorted_range, one_by_one)->Arg(1);
+BENCHMARK_TEMPLATE(benchmark_insert_sorted_range, boost_ordered_range)
+    ->Apply(set_delta_percent);
+BENCHMARK_TEMPLATE(benchmark_insert_sorted_range, insert_sorted_range)
+    ->Apply(set_delta_percent);
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+
+namespace srt {
+
+// flat_map<K, flat_set<V>> in three arrays (compressed sparse row):
+// sorted keys, offsets of their values and all of the values, sorted
+// within each key. One allocation per array instead of one per key.
+
+template <typename K, typename V>
+class flat_multimap_csr {
+  std::vector<K> keys_;
+  std::vector<std::size_t> offsets_{0};  // values of keys_[i] are
+  std::vector<V> values_;                // [offsets_[i], offsets_[i + 1])
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using values_iterator = typename std::vector<V>::const_iterator;
+  using values_range = range_pair<values_iterator>;
+
+  flat_multimap_csr() = default;
+
+  // [f, l) - pairs sorted by key and then by value, without duplicates.
+  template <typename I>
+  // requires ForwardIterator<I> && ValueType<I> == std::pair<K, V>
+  flat_multimap_csr(I f, I l) {
+    auto by_key = [](const auto& x, const auto& y) {
+      return x.first < y.first;
+    };
+
+    values_.reserve(static_cast<std::size_t>(std::distance(f, l)));
+    for (auto r : group_equals(f, l, by_key)) {
+      keys_.push_back(r.begin()->first);
+      for (const auto& elem : r) values_.push_back(elem.second);
+      offsets_.push_back(values_.size());
+    }
+    keys_.shrink_to_fit();
+    offsets_.shrink_to_fit();
+  }
+
+  std::size_t size() const { return keys_.size(); }
+  bool empty() const { return keys_.empty(); }
+  std::size_t values_size() const { return values_.size(); }
+
+  const std::vector<K>& keys() const { return keys_; }
+
+  values_range values_at(std::size_t i) const {
+    return {values_.begin() + static_cast<std::ptrdiff_t>(offsets_[i]),
+            values_.begin() + static_cast<std::ptrdiff_t>(offsets_[i + 1])};
+  }
+
+  // Index of the key, size() if there is none.
+  std::size_t find_index(const K& key) const {
+    auto it = lower_bound_biased(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || key < *it) return size();
+    return static_cast<std::size_t>(it - keys_.begin());
+  }
+
+  // Empty range for a missing key.
+  values_range values(const K& key) const {
+    std::size_t i = find_index(key);
+    if (i == size()) return {values_.end(), values_.end()};
+    return values_at(i);
+  }
+
+  bool contains(const K& key, const V& value) const {
+    values_range r = values(key);
+    auto it = lower_bound_biased(r.begin(), r.end(), value);
+    return it != r.end() && !(value < *it);
+  }
+
+  std::size_t memory_usage() const {
+    return sizeof(*this) + keys_.capacity() * sizeof(K) +
+           offsets_.capacity() * sizeof(std::size_t) +
+           values_.capacity() * sizeof(V);
+  }
+};
+
+}  // namespace srt
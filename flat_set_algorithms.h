@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include <boost/container/flat_set.hpp>
+
+#include "result.h"
+
+namespace srt {
+
+// Inserts the sorted range [f, l) into the flat set s. Equivalent
+// elements, in [f, l) or already in s, are kept once, the first one wins
+// (same as inserting them one by one).
+//
+// A first pass counts the new elements with lower_bound_biased from the
+// previous insertion point. Then the storage grows once and a backward
+// merge moves every run of old elements straight to its final place:
+// each element moves at most once, instead of once per insert before it.
+// Runs are found by galloping back from the end of the old elements.
+// The new slots at the end are filled first, from the top, by move (or
+// copy) construction into the reserved space: nothing is default
+// constructed.
+//
+// If counting or growing throws, s is unchanged. If copying, moving or
+// comparing throws during the merge, s is left empty.
+template <typename K, typename Compare, typename Allocator, typename I>
+// requires BidirectionalIterator<I> && ValueType<I> == K
+void insert_sorted_range(boost::container::flat_set<K, Compare, Allocator>& s,
+                         I f, I l) {
+  auto p = s.value_comp();
+
+  std::size_t added = 0;
+  auto found = s.begin();
+  for (I i = f; i != l; ++i) {
+    if (i != f && !p(*std::prev(i), *i)) continue;
+    found = lower_bound_biased(found, s.end(), *i, p);
+    if (found == s.end() || p(*i, *found)) ++added;
+  }
+  if (added == 0) return;
+
+  s.reserve(s.size() + added);
+  auto seq = s.extract_sequence();
+  using It = typename decltype(seq)::iterator;
+
+  const auto old_size = static_cast<std::ptrdiff_t>(seq.size());
+  It old_l = seq.end();
+  // Moves l to the first of the equivalent elements before it.
+  auto next_new = [&] {
+    --l;
+    while (l != f && !p(*std::prev(l), *l)) --l;
+  };
+
+  // The top `added` elements go to the new slots. They are pushed back
+  // from the largest down and then reversed; push_back does not
+  // reallocate, so the iterators stay valid.
+  bool pending = false;  // *l is the next new element
+  while (seq.size() != static_cast<std::size_t>(old_size) + added) {
+    if (!pending) next_new();
+    pending = true;
+    if (old_l != seq.begin() && p(*l, *std::prev(old_l))) {
+      seq.push_back(std::move(*--old_l));
+      continue;
+    }
+    if (old_l == seq.begin() || p(*std::prev(old_l), *l)) seq.push_back(*l);
+    pending = false;
+  }
+  std::reverse(seq.begin() + old_size, seq.end());
+
+  It out = seq.begin() + old_size;
+  // Once out meets old_l, the rest of [f, l) is already in s.
+  while (out != old_l) {
+    if (!pending) next_new();
+    pending = false;
+
+    It run = partition_point_biased(
+                 std::reverse_iterator<It>(old_l),
+                 std::reverse_iterator<It>(seq.begin()),
+                 [&](const K& x) { return p(*l, x); })
+                 .base();
+    out = std::move_backward(run, old_l, out);
+    old_l = run;
+    if (old_l == seq.begin() || p(*std::prev(old_l), *l)) *--out = *l;
+  }
+
+  s.adopt_sequence(boost::container::ordered_unique_range, std::move(seq));
+}
+
+}  // namespace srt
@@ -0,0 +1,105 @@
+#include "flat_set_algorithms.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+TEST_CASE("insert_sorted_range", "[flat_set_algorithms]") {
+  std::mt19937 g;
+
+  for (int max_value : {3, 100, 10000}) {
+    std::uniform_int_distribution<> values(0, max_value);
+
+    for (int size : {0, 1, 10, 100, 1000}) {
+      for (int delta_size : {0, 1, 10, 100, 1000}) {
+        std::vector<int> input(static_cast<std::size_t>(size));
+        for (int& x : input) x = values(g);
+        std::vector<int> delta(static_cast<std::size_t>(delta_size));
+        for (int& x : delta) x = values(g);
+        std::sort(delta.begin(), delta.end());
+
+        boost::container::flat_set<int> actual(input.begin(), input.end());
+        std::set<int> expected(input.begin(), input.end());
+        srt::insert_sorted_range(actual, delta.begin(), delta.end());
+        expected.insert(delta.begin(), delta.end());
+
+        REQUIRE(std::vector<int>(actual.begin(), actual.end()) ==
+                std::vector<int>(expected.begin(), expected.end()));
+      }
+    }
+  }
+}
+
+TEST_CASE("insert_sorted_range_first_wins", "[flat_set_algorithms]") {
+  using pair_t = std::pair<int, int>;
+  auto by_first = [](const pair_t& x, const pair_t& y) { return x.first < y.first; };
+  using set_t = boost::container::flat_set<pair_t, decltype(by_first)>;
+
+  set_t s(by_first);
+  for (int i = 0; i < 20; i += 2) s.insert({i, 0});
+
+  std::vector<pair_t> delta;
+  for (int i = 0; i < 20; ++i) {
+    delta.emplace_back(i, 1);
+    delta.emplace_back(i, 2);
+  }
+  srt::insert_sorted_range(s, delta.begin(), delta.end());
+
+  std::vector<pair_t> expected;
+  for (int i = 0; i < 20; ++i) expected.emplace_back(i, i % 2 == 0 ? 0 : 1);
+  REQUIRE(std::vector<pair_t>(s.begin(), s.end()) == expected);
+}
+
+namespace {
+
+struct no_default {
+  explicit no_default(int x) : x(x) {}
+  int x;
+};
+
+struct by_x {
+  bool operator()(const no_default& a, const no_default& b) const {
+    return a.x < b.x;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("insert_sorted_range_no_default_constructor",
+          "[flat_set_algorithms]") {
+  boost::container::flat_set<no_default, by_x> s;
+  for (int i = 0; i < 100; i += 3) s.insert(no_default(i));
+
+  std::vector<no_default> delta;
+  for (int i = 0; i < 100; i += 2) delta.emplace_back(i);
+  srt::insert_sorted_range(s, delta.begin(), delta.end());
+
+  std::vector<int> actual;
+  for (const auto& x : s) actual.push_back(x.x);
+  std::vector<int> expected;
+  for (int i = 0; i < 100; ++i)
+    if (i % 2 == 0 || i % 3 == 0) expected.push_back(i);
+  REQUIRE(actual == expected);
+}
+
+TEST_CASE("insert_sorted_range_throwing_count", "[flat_set_algorithms]") {
+  int calls_left = 0;
+  auto throwing = [&](int x, int y) {
+    if (calls_left-- == 0) throw 0;
+    return x < y;
+  };
+  boost::container::flat_set<int, decltype(throwing)> s(throwing);
+  calls_left = 1000;
+  for (int i = 0; i < 10; ++i) s.insert(i * 2);
+
+  std::vector<int> delta{1, 3, 5};
+  // Throws while counting the new elements.
+  calls_left = 1;
+  REQUIRE_THROWS(srt::insert_sorted_range(s, delta.begin(), delta.end()));
+  calls_left = 1000;
+  REQUIRE(std::vector<int>(s.begin(), s.end()) ==
+          std::vector<int>({0, 2, 4, 6, 8, 10, 12, 14, 16, 18}));
+}
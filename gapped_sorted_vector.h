@@ -0,0 +1,455 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+
+namespace srt {
+
+// Sorted set in an array with gaps (packed memory array). The array is
+// split into segments of ~log(capacity) slots, grouped into an implicit
+// binary tree of windows. An insert that does not fit in its segment
+// goes up the tree until a window is below its density threshold (1 for
+// a segment down to 3/4 for the whole array) and spreads that window
+// evenly. This costs O(log^2 n) amortized moves, rather than the O(n)
+// of a flat_set.
+//
+// A gap holds a copy of the next element (or of the last one, at the
+// end), so the slots are sorted as a whole: they are searched directly,
+// and then the answer is moved past the gaps. With a hint, the search
+// is lower_bound_hinted, so sequential inserts are O(1) searches.
+//
+// Appending in order is the bad case: it keeps refilling the last
+// windows, where a flat_set would just push_back. The range constructor
+// does not insert: it sorts the input and spreads it in one pass.
+//
+// Gaps are real, constructed Ts: T has to be copyable.
+
+template <typename T, typename Compare = less>
+class gapped_sorted_vector : Compare {
+  static constexpr std::size_t kMinCapacity = 16;
+  static constexpr std::size_t kMinSegmentSize = 8;
+  static constexpr std::size_t kWordBits = 64;
+
+  std::vector<T> slots_;
+  std::vector<std::uint64_t> occupied_;  // bitmap
+  std::vector<std::size_t> counts_;      // elements in every segment
+  std::vector<T> scratch_;               // elements of the window to spread
+  std::size_t segment_size_ = kMinSegmentSize;  // a power of 2
+  std::size_t segment_log_ = 3;
+  std::size_t size_ = 0;
+
+  Compare comp() const { return *this; }
+
+  std::size_t capacity() const { return slots_.size(); }
+
+  std::size_t segment(std::size_t i) const { return i >> segment_log_; }
+
+  bool is_occupied(std::size_t i) const {
+    return (occupied_[i / kWordBits] >> (i % kWordBits)) & 1;
+  }
+
+  void set_occupied(std::size_t i) {
+    occupied_[i / kWordBits] |= std::uint64_t{1} << (i % kWordBits);
+    ++counts_[segment(i)];
+  }
+
+  void reset_occupied(std::size_t i) {
+    occupied_[i / kWordBits] &= ~(std::uint64_t{1} << (i % kWordBits));
+    --counts_[segment(i)];
+  }
+
+  std::size_t next_occupied(std::size_t i) const {
+    if (i >= capacity()) return capacity();
+    std::size_t w = i / kWordBits;
+    std::uint64_t word = occupied_[w] & (~std::uint64_t{0} << (i % kWordBits));
+    while (word == 0) {
+      if (++w == occupied_.size()) return capacity();
+      word = occupied_[w];
+    }
+    return w * kWordBits + static_cast<std::size_t>(__builtin_ctzll(word));
+  }
+
+  // Gaps in [from, to), and the gaps right before it, which could be
+  // copies of its elements, take their values from the next element.
+  void refresh_gaps(std::size_t from, std::size_t to) {
+    while (from != 0 && !is_occupied(from - 1)) --from;
+    to = next_occupied(to);
+
+    std::size_t next = to;
+    for (std::size_t i = to; i-- != from;) {
+      if (is_occupied(i))
+        next = i;
+      else if (next != capacity())
+        slots_[i] = slots_[next];
+    }
+
+    if (to != capacity()) return;
+    // Trailing gaps copy the last element.
+    std::size_t last = to;
+    while (last != 0 && !is_occupied(last - 1)) --last;
+    if (last == 0) return;
+    for (std::size_t i = last; i != capacity(); ++i)
+      slots_[i] = slots_[last - 1];
+  }
+
+  // Moves the elements of scratch_ evenly into [from, from + width).
+  // Returns the slot of scratch_[marked].
+  std::size_t spread(std::size_t from, std::size_t width, std::size_t marked) {
+    for (std::size_t i = from; i != from + width;) {
+      if (i % kWordBits == 0 && from + width - i >= kWordBits) {
+        occupied_[i / kWordBits] = 0;
+        i += kWordBits;
+      } else {
+        occupied_[i / kWordBits] &= ~(std::uint64_t{1} << (i % kWordBits));
+        ++i;
+      }
+    }
+    std::fill(counts_.begin() + static_cast<std::ptrdiff_t>(segment(from)),
+              counts_.begin() + static_cast<std::ptrdiff_t>(segment(from + width)),
+              0);
+
+    // Slot j is at from + j * width / n, without dividing every time.
+    const std::size_t n = scratch_.size();
+    const std::size_t step = width / n;
+    const std::size_t step_remainder = width % n;
+    std::size_t slot = from;
+    std::size_t remainder = 0;
+    std::size_t res = 0;
+    for (std::size_t j = 0; j != n; ++j) {
+      slots_[slot] = std::move(scratch_[j]);
+      set_occupied(slot);
+      if (j == marked) res = slot;
+      slot += step;
+      remainder += step_remainder;
+      if (remainder >= n) {
+        remainder -= n;
+        ++slot;
+      }
+    }
+    scratch_.clear();
+    refresh_gaps(from, from + width);
+    return res;
+  }
+
+  // Moves the elements of [from, to) to scratch_.
+  void gather(std::size_t from, std::size_t to) {
+    for (std::size_t i = next_occupied(from); i < to; i = next_occupied(i + 1))
+      scratch_.push_back(std::move(slots_[i]));
+  }
+
+  // [from, from + width) is made of whole segments.
+  std::size_t count(std::size_t from, std::size_t width) const {
+    std::size_t res = 0;
+    for (std::size_t s = segment(from); s != segment(from + width); ++s)
+      res += counts_[s];
+    return res;
+  }
+
+  // Whether a window of `width` slots can hold `n` elements.
+  bool fits(std::size_t n, std::size_t width) const {
+    std::size_t levels = 0;
+    for (std::size_t w = segment_size_; w < capacity(); w *= 2) ++levels;
+    std::size_t level = 0;
+    for (std::size_t w = segment_size_; w < width; w *= 2) ++level;
+    // Threshold is 1 - level / (4 * levels).
+    if (levels == 0) return 4 * n <= 3 * width;
+    return 4 * levels * n <= (4 * levels - level) * width;
+  }
+
+  // Reallocates to `new_capacity` and spreads all the elements and v,
+  // which goes before the slot pos. Returns the slot of v.
+  template <typename U>
+  std::size_t rebuild(std::size_t new_capacity, std::size_t pos, U&& v) {
+    gather(0, pos);
+    std::size_t marked = scratch_.size();
+    scratch_.push_back(std::forward<U>(v));
+    gather(pos, capacity());
+    return rebuild(new_capacity, marked);
+  }
+
+  std::size_t rebuild(std::size_t new_capacity, std::size_t marked) {
+    std::size_t log = 0;
+    for (std::size_t c = new_capacity; c > 1; c /= 2) ++log;
+    segment_size_ = kMinSegmentSize;
+    segment_log_ = 3;
+    while (segment_size_ < log) {
+      segment_size_ *= 2;
+      ++segment_log_;
+    }
+
+    slots_.assign(new_capacity, scratch_.front());
+    occupied_.assign((new_capacity + kWordBits - 1) / kWordBits, 0);
+    counts_.assign(segment(new_capacity), 0);
+    return spread(0, new_capacity, marked);
+  }
+
+  static std::size_t capacity_for(std::size_t n) {
+    // At most half full after a rebuild.
+    std::size_t res = kMinCapacity;
+    while (res < 2 * n) res *= 2;
+    return res;
+  }
+
+  // The segment of `at` has a gap: shifts the elements between pos and
+  // the closest gap towards it. Returns where v goes.
+  std::size_t make_room(std::size_t at, std::size_t pos) {
+    std::size_t from = at & ~(segment_size_ - 1);
+    std::size_t to = from + segment_size_;
+
+    std::size_t right = pos;
+    while (right != to && is_occupied(right)) ++right;
+    std::size_t left = pos;
+    while (left != from && is_occupied(left - 1)) --left;
+
+    auto slot = [&](std::size_t i) {
+      return slots_.begin() + static_cast<std::ptrdiff_t>(i);
+    };
+    if (right != to && (left == from || right - pos <= pos - left)) {
+      std::move_backward(slot(pos), slot(right), slot(right + 1));
+      set_occupied(right);
+      return pos;
+    }
+    std::move(slot(left), slot(pos), slot(left - 1));
+    set_occupied(left - 1);
+    return pos - 1;
+  }
+
+  template <typename U>
+  std::size_t insert_before(std::size_t pos, U&& v) {
+    if (capacity() == 0 || !fits(size_ + 1, capacity()))
+      return rebuild(capacity_for(size_ + 1), pos, std::forward<U>(v));
+
+    std::size_t at = std::min(pos, capacity() - 1);
+    if (counts_[segment(at)] != segment_size_) {
+      std::size_t res = make_room(at, pos);
+      slots_[res] = std::forward<U>(v);
+      refresh_gaps(res, res + 1);
+      return res;
+    }
+
+    std::size_t width = 2 * segment_size_;
+    std::size_t from = at & ~(width - 1);
+    while (!fits(count(from, width) + 1, width)) {
+      width *= 2;
+      from = at & ~(width - 1);
+    }
+
+    gather(from, pos);
+    std::size_t marked = scratch_.size();
+    scratch_.push_back(std::forward<U>(v));
+    gather(pos, from + width);
+    return spread(from, width, marked);
+  }
+
+ public:
+  class iterator {
+    friend class gapped_sorted_vector;
+    const gapped_sorted_vector* c_ = nullptr;
+    std::size_t i_ = 0;
+    // Occupied slots after i_ in its word, so that scans don't wait for
+    // a load to find the next element.
+    std::uint64_t rest_ = 0;
+
+    iterator(const gapped_sorted_vector* c, std::size_t i) : c_(c), i_(i) {
+      load_rest();
+    }
+
+    void load_rest() {
+      rest_ = i_ < c_->capacity() ? c_->occupied_[i_ / kWordBits] &
+                                        (~std::uint64_t{1} << (i_ % kWordBits))
+                                  : 0;
+    }
+
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = const T*;
+    using reference = const T&;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    iterator() = default;
+
+    reference operator*() const { return c_->slots_[i_]; }
+    pointer operator->() const { return &c_->slots_[i_]; }
+
+    iterator& operator++() {
+      if (rest_ != 0) {
+        i_ = i_ / kWordBits * kWordBits +
+             static_cast<std::size_t>(__builtin_ctzll(rest_));
+        rest_ &= rest_ - 1;
+      } else {
+        i_ = c_->next_occupied((i_ / kWordBits + 1) * kWordBits);
+        load_rest();
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    iterator& operator--() {
+      do --i_;
+      while (!c_->is_occupied(i_));
+      load_rest();
+      return *this;
+    }
+
+    iterator operator--(int) {
+      auto tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    friend bool operator==(const iterator& x, const iterator& y) {
+      return x.i_ == y.i_;
+    }
+
+    friend bool operator!=(const iterator& x, const iterator& y) {
+      return !(x == y);
+    }
+  };
+
+  using value_type = T;
+  using const_iterator = iterator;
+
+  gapped_sorted_vector() = default;
+  explicit gapped_sorted_vector(Compare comp) : Compare(comp) {}
+
+  template <typename I>
+  // requires InputIterator<I> && ValueType<I> == T
+  gapped_sorted_vector(I f, I l, Compare comp = Compare{}) : Compare(comp) {
+    scratch_.assign(f, l);
+    // Of equivalent elements, the first one is kept, as with inserts.
+    std::stable_sort(scratch_.begin(), scratch_.end(), this->comp());
+    scratch_.erase(std::unique(scratch_.begin(), scratch_.end(),
+                               [&](const T& x, const T& y) {
+                                 return !this->comp()(x, y);
+                               }),
+                   scratch_.end());
+    size_ = scratch_.size();
+    if (size_ != 0) rebuild(capacity_for(size_), 0);
+  }
+
+  iterator begin() const { return {this, next_occupied(0)}; }
+  iterator end() const { return {this, capacity()}; }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  std::size_t memory_usage() const {
+    return sizeof(*this) + slots_.capacity() * sizeof(T) +
+           occupied_.capacity() * sizeof(std::uint64_t) +
+           counts_.capacity() * sizeof(std::size_t) +
+           scratch_.capacity() * sizeof(T);
+  }
+
+  void clear() {
+    slots_.clear();
+    occupied_.clear();
+    counts_.clear();
+    size_ = 0;
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  iterator lower_bound(const V& v) const {
+    auto it = lower_bound_n(slots_.begin(),
+                            static_cast<std::ptrdiff_t>(capacity()), v, comp());
+    return {this, next_occupied(static_cast<std::size_t>(it - slots_.begin()))};
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  iterator upper_bound(const V& v) const {
+    auto it = upper_bound_n(slots_.begin(),
+                            static_cast<std::ptrdiff_t>(capacity()), v, comp());
+    return {this, next_occupied(static_cast<std::size_t>(it - slots_.begin()))};
+  }
+
+  // Searches from the hint outwards: cheap if the answer is close.
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  iterator lower_bound(iterator hint, const V& v) const {
+    auto it = lower_bound_hinted(
+        slots_.begin(), slots_.begin() + static_cast<std::ptrdiff_t>(hint.i_),
+        slots_.end(), v, comp());
+    return {this, next_occupied(static_cast<std::size_t>(it - slots_.begin()))};
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  iterator find(const V& v) const {
+    iterator it = lower_bound(v);
+    return it != end() && !comp()(v, *it) ? it : end();
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  bool contains(const V& v) const {
+    return find(v) != end();
+  }
+
+  // Inserts invalidate all iterators.
+  std::pair<iterator, bool> insert(const T& v) {
+    return insert_at(lower_bound(v), v);
+  }
+  std::pair<iterator, bool> insert(T&& v) {
+    return insert_at(lower_bound(v), std::move(v));
+  }
+
+  // hint: where v is expected to be. Any iterator is correct.
+  std::pair<iterator, bool> insert(iterator hint, const T& v) {
+    return insert_at(lower_bound(hint, v), v);
+  }
+  std::pair<iterator, bool> insert(iterator hint, T&& v) {
+    return insert_at(lower_bound(hint, v), std::move(v));
+  }
+
+  // Invalidates all iterators if the array shrinks.
+  iterator erase(iterator pos) {
+    reset_occupied(pos.i_);
+    --size_;
+    if (capacity() > kMinCapacity && 4 * size_ < capacity()) {
+      if (size_ == 0) {
+        clear();
+        return end();
+      }
+      // Everything moves, the next element has to be found again.
+      T erased = std::move(slots_[pos.i_]);
+      gather(0, capacity());
+      rebuild(capacity_for(size_), 0);
+      return upper_bound(erased);
+    }
+    refresh_gaps(pos.i_, pos.i_ + 1);
+    return {this, next_occupied(pos.i_)};
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  std::size_t erase(const V& v) {
+    iterator it = find(v);
+    if (it == end()) return 0;
+    erase(it);
+    return 1;
+  }
+
+ private:
+  template <typename U>
+  std::pair<iterator, bool> insert_at(iterator lb, U&& v) {
+    if (lb != end() && !comp()(v, *lb)) return {lb, false};
+    std::size_t res = insert_before(lb.i_, std::forward<U>(v));
+    ++size_;
+    return {{this, res}, true};
+  }
+};
+
+}  // namespace srt
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <boost/container/flat_set.hpp>
+
+#include "gapped_sorted_vector.h"
+
+namespace {
+
+constexpr std::size_t kQueriesCount = 1u << 16;
+
+std::vector<std::int64_t> random_values(std::size_t size,
+                                        std::uint32_t seed = 0) {
+  std::mt19937 g(seed);
+  std::uniform_int_distribution<std::int64_t> values(0, 1000000000);
+  std::vector<std::int64_t> res(size);
+  for (auto& x : res) x = values(g);
+  return res;
+}
+
+void set_size(benchmark::internal::Benchmark* bench) {
+  for (int size : {1 << 10, 1 << 14, 1 << 17}) bench->Arg(size);
+}
+
+using flat_set = boost::container::flat_set<std::int64_t>;
+using gapped_sorted_vector = srt::gapped_sorted_vector<std::int64_t>;
+
+}  // namespace
+
+// Builds the container with random inserts, one at a time.
+template <typename Container>
+void benchmark_set_random_inserts(benchmark::State& state) {
+  const auto values = random_values(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    Container c;
+    for (auto v : values) c.insert(v);
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+}
+
+// Inserts in ascending order, with end() as the hint.
+template <typename Container>
+void benchmark_set_sequential_inserts(benchmark::State& state) {
+  const auto n = state.range(0);
+
+  for (auto _ : state) {
+    Container c;
+    for (std::int64_t v = 0; v != n; ++v) c.insert(c.end(), v);
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * n);
+}
+
+// From a range of random values, in one call.
+template <typename Container>
+void benchmark_set_build(benchmark::State& state) {
+  const auto values = random_values(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    Container c(values.begin(), values.end());
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+}
+
+template <typename Container>
+void benchmark_set_lookup(benchmark::State& state) {
+  const auto values = random_values(static_cast<std::size_t>(state.range(0)));
+  Container c;
+  for (auto v : values) c.insert(v);
+  const auto queries = random_values(kQueriesCount, 1);
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(c.lower_bound(queries[i]));
+    i = (i + 1) % queries.size();
+  }
+}
+
+template <typename Container>
+void benchmark_set_scan(benchmark::State& state) {
+  const auto values = random_values(static_cast<std::size_t>(state.range(0)));
+  Container c;
+  for (auto v : values) c.insert(v);
+
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (auto x : c) sum += x;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(c.size()));
+}
+
+BENCHMARK_TEMPLATE(benchmark_set_random_inserts, flat_set)->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_random_inserts, gapped_sorted_vector)
+    ->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_sequential_inserts, flat_set)->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_sequential_inserts, gapped_sorted_vector)
+    ->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_build, flat_set)->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_build, gapped_sorted_vector)->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_lookup, flat_set)->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_lookup, gapped_sorted_vector)->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_scan, flat_set)->Apply(set_size);
+BENCHMARK_TEMPLATE(benchmark_set_scan, gapped_sorted_vector)->Apply(set_size);
@@ -0,0 +1,122 @@
+#include "gapped_sorted_vector.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+TEST_CASE("gapped_sorted_vector", "[gapped_sorted_vector]") {
+  std::mt19937 g;
+
+  for (int max_value : {3, 100, 10000}) {
+    std::uniform_int_distribution<int> dis(0, max_value);
+    srt::gapped_sorted_vector<int> actual;
+    std::set<int> expected;
+
+    for (int i = 0; i < 3000; ++i) {
+      int v = dis(g);
+      if (i % 3 == 2) {
+        REQUIRE(actual.erase(v) == expected.erase(v));
+      } else if (i % 7 == 6) {
+        auto it = actual.lower_bound(v);
+        auto expected_it = expected.lower_bound(v);
+        if (expected_it != expected.end()) {
+          REQUIRE(*it == *expected_it);
+          auto next = actual.erase(it);
+          expected_it = expected.erase(expected_it);
+          if (expected_it == expected.end())
+            REQUIRE(next == actual.end());
+          else
+            REQUIRE(*next == *expected_it);
+        }
+      } else if (i % 5 == 4) {
+        auto hint = actual.lower_bound(dis(g));
+        auto r = actual.insert(hint, v);
+        REQUIRE(*r.first == v);
+        REQUIRE(r.second == expected.insert(v).second);
+      } else {
+        auto r = actual.insert(v);
+        REQUIRE(*r.first == v);
+        REQUIRE(r.second == expected.insert(v).second);
+      }
+
+      REQUIRE(actual.size() == expected.size());
+      REQUIRE(std::equal(actual.begin(), actual.end(), expected.begin(),
+                         expected.end()));
+      REQUIRE(std::equal(std::reverse_iterator<decltype(actual.end())>(
+                             actual.end()),
+                         std::reverse_iterator<decltype(actual.begin())>(
+                             actual.begin()),
+                         expected.rbegin(), expected.rend()));
+
+      for (int x : {v - 1, v, v + 1}) {
+        REQUIRE(std::distance(actual.begin(), actual.lower_bound(x)) ==
+                std::distance(expected.begin(), expected.lower_bound(x)));
+        REQUIRE(std::distance(actual.begin(), actual.upper_bound(x)) ==
+                std::distance(expected.begin(), expected.upper_bound(x)));
+        REQUIRE(actual.contains(x) == (expected.count(x) != 0));
+      }
+    }
+
+    // Erasing everything shrinks back.
+    while (!actual.empty()) actual.erase(actual.begin());
+    REQUIRE(actual.begin() == actual.end());
+    REQUIRE(!actual.contains(0));
+  }
+}
+
+TEST_CASE("gapped_sorted_vector_hints", "[gapped_sorted_vector]") {
+  std::vector<int> input(1000);
+  std::iota(input.begin(), input.end(), 0);
+
+  // Sequential inserts at the end, and then in the middle of each gap.
+  srt::gapped_sorted_vector<int> s;
+  for (int x : input) s.insert(s.end(), x);
+  REQUIRE(std::vector<int>(s.begin(), s.end()) == input);
+
+  srt::gapped_sorted_vector<int> descending;
+  for (auto it = input.rbegin(); it != input.rend(); ++it)
+    descending.insert(descending.begin(), *it);
+  REQUIRE(std::vector<int>(descending.begin(), descending.end()) == input);
+
+  for (auto h = s.begin(); h != s.end(); ++h) {
+    for (int v : {-1, 0, 500, 999, 1000}) {
+      REQUIRE(s.lower_bound(h, v) == s.lower_bound(v));
+    }
+  }
+}
+
+TEST_CASE("gapped_sorted_vector_strings", "[gapped_sorted_vector]") {
+  std::vector<std::string> input;
+  for (int i = 0; i < 300; ++i) input.push_back(std::to_string(i * 7 % 300));
+
+  srt::gapped_sorted_vector<std::string, std::greater<>> s(input.begin(),
+                                                           input.end());
+  std::set<std::string, std::greater<>> expected(input.begin(), input.end());
+  REQUIRE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+
+  // Unsorted, with duplicates.
+  std::vector<std::string> twice = input;
+  twice.insert(twice.end(), input.rbegin(), input.rend());
+  srt::gapped_sorted_vector<std::string, std::greater<>> from_twice(
+      twice.begin(), twice.end());
+  REQUIRE(std::equal(from_twice.begin(), from_twice.end(), expected.begin(),
+                     expected.end()));
+  REQUIRE(from_twice.size() == expected.size());
+  for (const auto& x : input) REQUIRE(from_twice.contains(x));
+
+  srt::gapped_sorted_vector<std::string, std::greater<>> from_empty(
+      input.end(), input.end());
+  REQUIRE(from_empty.empty());
+  REQUIRE(from_empty.begin() == from_empty.end());
+
+  auto copy = s;
+  for (const auto& x : input) REQUIRE(copy.erase(x) == 1);
+  REQUIRE(copy.empty());
+  REQUIRE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+}
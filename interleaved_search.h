@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include "result.h"
+
+// Searches for many unsorted needles at once. A search over a big
+// haystack is a chain of dependent cache misses, so we keep G searches
+// in flight, prefetch the next probe of each one and round-robin
+// between them (AMAC - "asynchronous memory access chaining").
+//
+// P(x, needle) is the partitioning predicate for a given needle.
+
+namespace srt {
+
+template <typename I>
+// requires RandomAccessIterator<I>
+void prefetch(I it) {
+  __builtin_prefetch(std::addressof(*it));
+}
+
+template <std::size_t G, typename I, typename J, typename O, typename P>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          OutputIterator<O, I> &&
+//          Predicate<P(ValueType<I>, ValueType<J>)>
+O partition_point_n_interleaved(I f, DifferenceType<I> n, J needles_f,
+                                J needles_l, O out, P p) {
+  static_assert(G > 0, "group size can't be 0");
+
+  // With branchless bisection, all searches over the same n take the
+  // same steps, so a group can go in lockstep.
+  std::array<I, G> group;
+
+  while (needles_f != needles_l) {
+    J group_needles_f = needles_f;
+    std::size_t size = 0;
+    for (; size != G && needles_f != needles_l; ++size, ++needles_f)
+      group[size] = f;
+
+    if (n != 0) {
+      for (DifferenceType<I> m = n; m > 1; m -= m / 2) {
+        DifferenceType<I> m2 = m / 2;
+        for (std::size_t i = 0; i != size; ++i) prefetch(group[i] + m2);
+
+        J needle = group_needles_f;
+        for (std::size_t i = 0; i != size; ++i, ++needle)
+          group[i] += p(group[i][m2], *needle) ? m2 : 0;
+      }
+
+      J needle = group_needles_f;
+      for (std::size_t i = 0; i != size; ++i, ++needle)
+        group[i] += static_cast<DifferenceType<I>>(p(*group[i], *needle));
+    }
+
+    out = std::copy(group.begin(), group.begin() + size, out);
+  }
+
+  return out;
+}
+
+template <std::size_t G, typename I, typename J, typename O, typename P>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          OutputIterator<O, I> &&
+//          StrictWeakOrder<P(ValueType<I>, ValueType<J>)>
+O lower_bound_n_interleaved(I f, DifferenceType<I> n, J needles_f,
+                            J needles_l, O out, P p) {
+  return partition_point_n_interleaved<G>(
+      f, n, needles_f, needles_l, out,
+      [&](const auto& x, const auto& v) { return p(x, v); });
+}
+
+template <std::size_t G, typename I, typename J, typename O>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          OutputIterator<O, I> &&
+//          WeakComarable<ValueType<I>, ValueType<J>>
+O lower_bound_n_interleaved(I f, DifferenceType<I> n, J needles_f,
+                            J needles_l, O out) {
+  return lower_bound_n_interleaved<G>(f, n, needles_f, needles_l, out, less{});
+}
+
+template <std::size_t G, typename I, typename J, typename O, typename P>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          OutputIterator<O, I> &&
+//          StrictWeakOrder<P(ValueType<I>, ValueType<J>)>
+O upper_bound_n_interleaved(I f, DifferenceType<I> n, J needles_f,
+                            J needles_l, O out, P p) {
+  return partition_point_n_interleaved<G>(
+      f, n, needles_f, needles_l, out,
+      [&](const auto& x, const auto& v) { return !p(v, x); });
+}
+
+template <std::size_t G, typename I, typename J, typename O>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          OutputIterator<O, I> &&
+//          WeakComarable<ValueType<I>, ValueType<J>>
+O upper_bound_n_interleaved(I f, DifferenceType<I> n, J needles_f,
+                            J needles_l, O out) {
+  return upper_bound_n_interleaved<G>(f, n, needles_f, needles_l, out, less{});
+}
+
+// Biased searches take a different number of steps for different
+// needles, so here every slot is a small state machine: it gallops
+// like partition_point_biased_branchless and then bisects. A finished
+// slot writes its result and picks up the next needle.
+//
+// Both phases probe some f[i] and then either go to [f + i + 1, f + n)
+// or to [f, f + i), so one step is the same code for both of them and
+// compiles to conditional moves.
+
+template <typename I, typename J>
+struct biased_search_state {
+  I f;
+  DifferenceType<I> n = 0;     // elements left in [f, l)
+  DifferenceType<I> step = 0;  // 0 once galloping is over.
+  J needle;
+  std::ptrdiff_t idx = -1;     // -1 for a free slot.
+
+  DifferenceType<I> probe_offset() const {
+    return step != 0 ? step - 1 : n / 2;
+  }
+
+  I probe() const { return f + probe_offset(); }
+
+  // One probe of the search, returns true when done.
+  template <typename P>
+  bool advance(P p) {
+    DifferenceType<I> i = probe_offset();
+    bool is_true = p(f[i], *needle);
+    f += is_true ? i + 1 : 0;
+    n = is_true ? n - i - 1 : i;
+    step = is_true ? step + step : 0;
+    step = step > n ? 0 : step;
+    return n == 0;
+  }
+};
+
+template <std::size_t G, typename I, typename J, typename O, typename P>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          RandomAccessIterator<O> && Writable<O, I> &&
+//          Predicate<P(ValueType<I>, ValueType<J>)>
+O partition_point_biased_interleaved(I f, I l, J needles_f, J needles_l,
+                                     O out, P p) {
+  static_assert(G > 0, "group size can't be 0");
+
+  if (f == l) {
+    std::ptrdiff_t size = 0;
+    for (; needles_f != needles_l; ++needles_f) out[size++] = f;
+    return out + size;
+  }
+
+  std::array<biased_search_state<I, J>, G> slots;
+  std::ptrdiff_t taken = 0;
+  std::size_t active = 0;
+
+  auto take_needle = [&](biased_search_state<I, J>& s) {
+    if (needles_f == needles_l) {
+      s.idx = -1;
+      return;
+    }
+    s.f = f;
+    s.n = l - f;
+    s.step = 1;
+    s.needle = needles_f++;
+    s.idx = taken++;
+    ++active;
+    prefetch(s.probe());
+  };
+
+  for (auto& s : slots) take_needle(s);
+
+  while (active != 0) {
+    for (auto& s : slots) {
+      if (s.idx == -1) continue;
+      if (s.advance(p)) {
+        out[s.idx] = s.f;
+        --active;
+        take_needle(s);
+      } else {
+        prefetch(s.probe());
+      }
+    }
+  }
+
+  return out + taken;
+}
+
+template <std::size_t G, typename I, typename J, typename O, typename P>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          RandomAccessIterator<O> && Writable<O, I> &&
+//          StrictWeakOrder<P(ValueType<I>, ValueType<J>)>
+O lower_bound_biased_interleaved(I f, I l, J needles_f, J needles_l, O out,
+                                 P p) {
+  return partition_point_biased_interleaved<G>(
+      f, l, needles_f, needles_l, out,
+      [&](const auto& x, const auto& v) { return p(x, v); });
+}
+
+template <std::size_t G, typename I, typename J, typename O>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          RandomAccessIterator<O> && Writable<O, I> &&
+//          WeakComarable<ValueType<I>, ValueType<J>>
+O lower_bound_biased_interleaved(I f, I l, J needles_f, J needles_l, O out) {
+  return lower_bound_biased_interleaved<G>(f, l, needles_f, needles_l, out,
+                                           less{});
+}
+
+template <std::size_t G, typename I, typename J, typename O, typename P>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          RandomAccessIterator<O> && Writable<O, I> &&
+//          StrictWeakOrder<P(ValueType<I>, ValueType<J>)>
+O upper_bound_biased_interleaved(I f, I l, J needles_f, J needles_l, O out,
+                                 P p) {
+  return partition_point_biased_interleaved<G>(
+      f, l, needles_f, needles_l, out,
+      [&](const auto& x, const auto& v) { return !p(v, x); });
+}
+
+template <std::size_t G, typename I, typename J, typename O>
+// requires RandomAccessIterator<I> && ForwardIterator<J> &&
+//          RandomAccessIterator<O> && Writable<O, I> &&
+//          WeakComarable<ValueType<I>, ValueType<J>>
+O upper_bound_biased_interleaved(I f, I l, J needles_f, J needles_l, O out) {
+  return upper_bound_biased_interleaved<G>(f, l, needles_f, needles_l, out,
+                                           less{});
+}
+
+}  // namespace srt
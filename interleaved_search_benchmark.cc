@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "interleaved_search.h"
+
+namespace {
+
+constexpr std::size_t kNeedlesCount = 1u << 16;
+
+// Sorted, grows on demand: any prefix is a valid haystack.
+const std::vector<std::int64_t>& haystack(std::size_t size) {
+  static std::vector<std::int64_t> res;
+  static std::mt19937 g;
+
+  std::uniform_int_distribution<std::int64_t> dis(0, 9);
+  res.reserve(size);
+  while (res.size() < size)
+    res.push_back(static_cast<std::int64_t>(res.size()) * 10 + dis(g));
+
+  return res;
+}
+
+const std::vector<std::int64_t>& needles(std::size_t haystack_size) {
+  static std::vector<std::int64_t> res;
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(
+      0, static_cast<std::int64_t>(haystack_size) * 10);
+
+  res.resize(kNeedlesCount);
+  for (auto& x : res) x = dis(g);
+  return res;
+}
+
+void set_haystack_size(benchmark::internal::Benchmark* bench) {
+  for (std::size_t size = 1000; size <= 100000000; size *= 10)
+    bench->Arg(static_cast<int>(size));
+}
+
+struct n_loop {
+  template <typename I, typename J, typename O>
+  O operator()(I f, I l, J needles_f, J needles_l, O out) {
+    for (; needles_f != needles_l; ++needles_f)
+      *out++ = srt::lower_bound_n(f, l - f, *needles_f);
+    return out;
+  }
+};
+
+template <std::size_t G>
+struct n_interleaved {
+  template <typename I, typename J, typename O>
+  O operator()(I f, I l, J needles_f, J needles_l, O out) {
+    return srt::lower_bound_n_interleaved<G>(f, l - f, needles_f, needles_l,
+                                             out);
+  }
+};
+
+struct biased_loop {
+  template <typename I, typename J, typename O>
+  O operator()(I f, I l, J needles_f, J needles_l, O out) {
+    for (; needles_f != needles_l; ++needles_f)
+      *out++ = srt::lower_bound_biased(f, l, *needles_f);
+    return out;
+  }
+};
+
+template <std::size_t G>
+struct biased_interleaved {
+  template <typename I, typename J, typename O>
+  O operator()(I f, I l, J needles_f, J needles_l, O out) {
+    return srt::lower_bound_biased_interleaved<G>(f, l, needles_f, needles_l,
+                                                  out);
+  }
+};
+
+}  // namespace
+
+template <typename Searcher>
+void benchmark_interleaved_search(benchmark::State& state) {
+  auto size = static_cast<std::size_t>(state.range(0));
+  const auto& input = haystack(size);
+  const auto& looking_for = needles(size);
+  std::vector<std::vector<std::int64_t>::const_iterator> out(
+      looking_for.size());
+
+  for (auto _ : state) {
+    Searcher{}(input.begin(), input.begin() + state.range(0),
+               looking_for.begin(), looking_for.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(looking_for.size()));
+}
+
+BENCHMARK_TEMPLATE(benchmark_interleaved_search, n_loop)->Apply(set_haystack_size);
+BENCHMARK_TEMPLATE(benchmark_interleaved_search, n_interleaved<8>)->Apply(set_haystack_size);
+BENCHMARK_TEMPLATE(benchmark_interleaved_search, n_interleaved<16>)->Apply(set_haystack_size);
+BENCHMARK_TEMPLATE(benchmark_interleaved_search, biased_loop)->Apply(set_haystack_size);
+BENCHMARK_TEMPLATE(benchmark_interleaved_search, biased_interleaved<8>)->Apply(set_haystack_size);
+BENCHMARK_TEMPLATE(benchmark_interleaved_search, biased_interleaved<16>)->Apply(set_haystack_size);
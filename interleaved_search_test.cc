@@ -0,0 +1,60 @@
+#include "interleaved_search.h"
+#include "third_party/catch.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+template <std::size_t G>
+void test_interleaved() {
+  std::mt19937 g;
+
+  for (int size = 0; size < 70; ++size) {
+    std::vector<int> haystack;
+    for (int i = 0; i < size; ++i) haystack.push_back(i / 3);
+
+    std::uniform_int_distribution<int> dis(-1, size / 3 + 1);
+    std::vector<int> needles(static_cast<std::size_t>(size + 5));
+    for (int& x : needles) x = dis(g);
+
+    using I = std::vector<int>::const_iterator;
+    auto f = haystack.cbegin();
+    auto l = haystack.cend();
+
+    std::vector<I> lb_n, ub_n, lb_biased, ub_biased;
+    srt::lower_bound_n_interleaved<G>(f, size, needles.begin(), needles.end(),
+                                      std::back_inserter(lb_n));
+    srt::upper_bound_n_interleaved<G>(f, size, needles.begin(), needles.end(),
+                                      std::back_inserter(ub_n));
+
+    lb_biased.resize(needles.size());
+    ub_biased.resize(needles.size());
+    REQUIRE(srt::lower_bound_biased_interleaved<G>(f, l, needles.begin(),
+                                                   needles.end(),
+                                                   lb_biased.begin()) ==
+            lb_biased.end());
+    REQUIRE(srt::upper_bound_biased_interleaved<G>(f, l, needles.begin(),
+                                                   needles.end(),
+                                                   ub_biased.begin()) ==
+            ub_biased.end());
+
+    REQUIRE(lb_n.size() == needles.size());
+    REQUIRE(ub_n.size() == needles.size());
+
+    for (std::size_t i = 0; i != needles.size(); ++i) {
+      REQUIRE(lb_n[i] == std::lower_bound(f, l, needles[i]));
+      REQUIRE(ub_n[i] == std::upper_bound(f, l, needles[i]));
+      REQUIRE(lb_biased[i] == std::lower_bound(f, l, needles[i]));
+      REQUIRE(ub_biased[i] == std::upper_bound(f, l, needles[i]));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("interleaved_search", "[interleaved]") {
+  test_interleaved<1>();
+  test_interleaved<3>();
+  test_interleaved<8>();
+}
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "result.h"
+
+namespace {
+
+constexpr std::size_t kKeysCount = 1000000u;
+constexpr std::size_t kQueriesCount = 1u << 16;
+
+enum key_distribution : int {
+  kUniform = 0,      // like ints_test()
+  kExponential = 1,  // keys grow as e^x
+  kOutlier = 2       // uniform, but the last key is huge
+};
+
+const std::vector<std::int64_t>& sorted_keys(int distribution) {
+  static std::vector<std::int64_t> res;
+  static int cached = -1;
+  if (cached == distribution) return res;
+  cached = distribution;
+
+  std::mt19937 g;
+  res.resize(kKeysCount);
+  if (distribution == kExponential) {
+    std::uniform_real_distribution<double> dis(0, 40);
+    for (auto& x : res) x = static_cast<std::int64_t>(std::exp(dis(g)));
+  } else {
+    std::uniform_int_distribution<std::int64_t> dis(
+        1, static_cast<std::int64_t>(kKeysCount) * 10);
+    for (auto& x : res) x = dis(g);
+  }
+  std::sort(res.begin(), res.end());
+  if (distribution == kOutlier) res.back() = std::int64_t{1} << 62;
+  return res;
+}
+
+void set_distribution(benchmark::internal::Benchmark* bench) {
+  for (int distribution : {kUniform, kExponential, kOutlier})
+    bench->Arg(distribution);
+}
+
+// Classic interpolation search, for reference: O(n) probes on the worst
+// inputs.
+template <typename I, typename V>
+I lower_bound_interpolation(I f, I l, const V& v) {
+  if (f == l || !(*f < v)) return f;
+  if (*(l - 1) < v) return l;
+
+  // *f < v <= *hi
+  I hi = l - 1;
+  while (hi - f > 1) {
+    I m = f + srt::interpolate(f, 0, hi - f, v);
+    m = std::min(std::max(m, f + 1), hi - 1);
+    if (*m < v)
+      f = m;
+    else
+      hi = m;
+  }
+  return hi;
+}
+
+struct std_lower_bound {
+  template <typename I, typename V>
+  I operator()(I f, I l, const V& v) {
+    return std::lower_bound(f, l, v);
+  }
+};
+
+struct interpolation {
+  template <typename I, typename V>
+  I operator()(I f, I l, const V& v) {
+    return lower_bound_interpolation(f, l, v);
+  }
+};
+
+struct interpolated_biased {
+  template <typename I, typename V>
+  I operator()(I f, I l, const V& v) {
+    return srt::lower_bound_interpolated_biased(f, l, v);
+  }
+};
+
+}  // namespace
+
+template <typename Searcher>
+void benchmark_interpolation(benchmark::State& state) {
+  const auto& keys = sorted_keys(static_cast<int>(state.range(0)));
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::size_t> dis(0, keys.size() - 2);
+  std::vector<std::int64_t> queries(kQueriesCount);
+  for (auto& x : queries) x = keys[dis(g)];
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Searcher{}(keys.begin(), keys.end(), queries[i]));
+    i = (i + 1) % queries.size();
+  }
+}
+
+BENCHMARK_TEMPLATE(benchmark_interpolation, std_lower_bound)->Apply(set_distribution);
+BENCHMARK_TEMPLATE(benchmark_interpolation, interpolation)->Apply(set_distribution);
+BENCHMARK_TEMPLATE(benchmark_interpolation, interpolated_biased)->Apply(set_distribution);
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "result.h"
+
+namespace srt {
+
+// Sorted arithmetic keys with a piecewise linear model of key -> position
+// (PGM style). The segments are built greedily with a "shrinking cone":
+// a segment is extended while some slope keeps every key within
+// `epsilon` positions of its prediction. A lookup finds the segment,
+// predicts the position and finishes with lower_bound_hinted, which
+// gallops out of the hint - so its cost depends on the actual error.
+//
+// With duplicates, the model predicts the first position of a key.
+
+struct learned_index_stats {
+  std::size_t segments = 0;
+  std::size_t model_bytes = 0;
+  std::size_t max_error = 0;
+  double mean_error = 0;
+};
+
+template <typename K>
+class learned_index {
+  static_assert(std::is_arithmetic<K>::value, "the model is linear in K");
+
+  struct segment {
+    std::size_t position;  // of the first key
+    double slope;
+  };
+
+  std::vector<K> keys_;
+  std::vector<K> segment_keys_;  // first key of every segment
+  std::vector<segment> segments_;
+  learned_index_stats stats_;
+
+  std::size_t predict(std::size_t s, K v) const {
+    double offset = (static_cast<double>(v) -
+                     static_cast<double>(segment_keys_[s])) *
+                    segments_[s].slope;
+    double res = static_cast<double>(segments_[s].position) + offset;
+    // Also takes care of NaN.
+    if (!(res >= 0)) return 0;
+    if (res >= static_cast<double>(keys_.size())) return keys_.size();
+    return static_cast<std::size_t>(res);
+  }
+
+  void build(std::size_t epsilon) {
+    const double eps = static_cast<double>(epsilon);
+
+    std::size_t i = 0;
+    while (i != keys_.size()) {
+      segment_keys_.push_back(keys_[i]);
+      double lo = 0;
+      double hi = std::numeric_limits<double>::infinity();
+
+      std::size_t j = i + 1;
+      for (; j != keys_.size(); ++j) {
+        if (!(keys_[j - 1] < keys_[j])) continue;  // not a first position
+
+        double dk =
+            static_cast<double>(keys_[j]) - static_cast<double>(keys_[i]);
+        double dp = static_cast<double>(j - i);
+        double new_lo = std::max(lo, (dp - eps) / dk);
+        double new_hi = std::min(hi, (dp + eps) / dk);
+        if (new_lo > new_hi) break;
+        lo = new_lo;
+        hi = new_hi;
+      }
+
+      segments_.push_back({i, std::isinf(hi) ? 0.0 : (lo + hi) / 2});
+      i = j;
+    }
+
+    segment_keys_.shrink_to_fit();
+    segments_.shrink_to_fit();
+
+    stats_.segments = segments_.size();
+    stats_.model_bytes = segment_keys_.capacity() * sizeof(K) +
+                         segments_.capacity() * sizeof(segment);
+
+    // Measured, rather than trusting the bound: rounding can push a
+    // prediction over epsilon.
+    double total_error = 0;
+    std::size_t first_positions = 0;
+    std::size_t s = 0;
+    for (std::size_t k = 0; k != keys_.size(); ++k) {
+      if (k != 0 && !(keys_[k - 1] < keys_[k])) continue;
+      if (s + 1 != segments_.size() && segments_[s + 1].position == k) ++s;
+      std::size_t predicted = predict(s, keys_[k]);
+      std::size_t error = predicted > k ? predicted - k : k - predicted;
+      stats_.max_error = std::max(stats_.max_error, error);
+      total_error += static_cast<double>(error);
+      ++first_positions;
+    }
+    if (first_positions != 0)
+      stats_.mean_error = total_error / static_cast<double>(first_positions);
+  }
+
+ public:
+  using value_type = K;
+  using const_iterator = typename std::vector<K>::const_iterator;
+
+  static constexpr std::size_t kDefaultEpsilon = 32;
+
+  learned_index() = default;
+
+  // [f, l) is sorted.
+  template <typename I>
+  // requires ForwardIterator<I> && ValueType<I> == K
+  learned_index(I f, I l, std::size_t epsilon = kDefaultEpsilon)
+      : keys_(f, l) {
+    build(epsilon);
+  }
+
+  const_iterator begin() const { return keys_.begin(); }
+  const_iterator end() const { return keys_.end(); }
+  std::size_t size() const { return keys_.size(); }
+  bool empty() const { return keys_.empty(); }
+
+  const learned_index_stats& stats() const { return stats_; }
+
+  // Position the model predicts for v.
+  const_iterator hint(K v) const {
+    if (segments_.empty()) return end();
+    auto s = upper_bound_n(segment_keys_.begin(),
+                           static_cast<std::ptrdiff_t>(segment_keys_.size()),
+                           v) -
+             segment_keys_.begin();
+    s = std::max<std::ptrdiff_t>(s - 1, 0);
+    return begin() + static_cast<std::ptrdiff_t>(
+                         predict(static_cast<std::size_t>(s), v));
+  }
+
+  const_iterator lower_bound(K v) const {
+    return lower_bound_hinted(begin(), hint(v), end(), v);
+  }
+
+  const_iterator upper_bound(K v) const {
+    return upper_bound_hinted(begin(), hint(v), end(), v);
+  }
+
+  range_pair<const_iterator> equal_range(K v) const {
+    auto lb = lower_bound(v);
+    return {lb, upper_bound_biased(lb, end(), v)};
+  }
+};
+
+}  // namespace srt
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "learned_index.h"
+
+namespace {
+
+constexpr std::size_t kKeysCount = 10000000u;
+constexpr std::size_t kQueriesCount = 1u << 16;
+
+enum key_distribution : int {
+  kUniform = 0,
+  kLognormal = 1,
+  kClustered = 2  // dense runs of keys far apart from each other
+};
+
+std::vector<std::int64_t> sorted_keys(int distribution) {
+  std::mt19937 g;
+  std::vector<std::int64_t> res(kKeysCount);
+
+  if (distribution == kUniform) {
+    std::uniform_int_distribution<std::int64_t> dis(0, 1ll << 40);
+    for (auto& x : res) x = dis(g);
+  } else if (distribution == kLognormal) {
+    std::lognormal_distribution<double> dis(0, 2);
+    for (auto& x : res) x = static_cast<std::int64_t>(dis(g) * 1e9);
+  } else {
+    std::uniform_int_distribution<std::int64_t> centers(0, 1ll << 40);
+    std::exponential_distribution<double> cluster_size(1.0 / 1000);
+    std::normal_distribution<double> spread(0, 10000);
+    std::size_t i = 0;
+    while (i != res.size()) {
+      std::int64_t center = centers(g);
+      auto size = std::min(static_cast<std::size_t>(cluster_size(g)) + 1,
+                           res.size() - i);
+      for (; size != 0; --size)
+        res[i++] = center + static_cast<std::int64_t>(spread(g));
+    }
+  }
+
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+void set_distribution(benchmark::internal::Benchmark* bench) {
+  for (int distribution : {kUniform, kLognormal, kClustered})
+    bench->Arg(distribution);
+}
+
+void set_distribution_and_epsilon(benchmark::internal::Benchmark* bench) {
+  for (int distribution : {kUniform, kLognormal, kClustered})
+    for (int epsilon : {8, 32, 128}) bench->Args({distribution, epsilon});
+}
+
+template <typename Searcher>
+void run_lookups(benchmark::State& state,
+                 const std::vector<std::int64_t>& keys, Searcher searcher) {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::size_t> dis(0, keys.size() - 1);
+  std::vector<std::int64_t> queries(kQueriesCount);
+  for (auto& x : queries) x = keys[dis(g)];
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(searcher(queries[i]));
+    i = (i + 1) % queries.size();
+  }
+}
+
+}  // namespace
+
+void benchmark_lookup_std(benchmark::State& state) {
+  const auto keys = sorted_keys(static_cast<int>(state.range(0)));
+  run_lookups(state, keys, [&](std::int64_t v) {
+    return std::lower_bound(keys.begin(), keys.end(), v);
+  });
+}
+
+void benchmark_lookup_learned(benchmark::State& state) {
+  const auto keys = sorted_keys(static_cast<int>(state.range(0)));
+  const srt::learned_index<std::int64_t> index(
+      keys.begin(), keys.end(), static_cast<std::size_t>(state.range(1)));
+  run_lookups(state, keys,
+              [&](std::int64_t v) { return index.lower_bound(v); });
+
+  const auto& stats = index.stats();
+  state.counters["segments"] = static_cast<double>(stats.segments);
+  state.counters["model_bytes"] = static_cast<double>(stats.model_bytes);
+  state.counters["max_error"] = static_cast<double>(stats.max_error);
+  state.counters["mean_error"] = stats.mean_error;
+}
+
+BENCHMARK(benchmark_lookup_std)->Apply(set_distribution);
+BENCHMARK(benchmark_lookup_learned)->Apply(set_distribution_and_epsilon);
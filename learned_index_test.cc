@@ -0,0 +1,63 @@
+#include "learned_index.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename K, typename Gen>
+void test_learned_index(Gen gen) {
+  std::mt19937 g;
+
+  for (std::size_t size : {0u, 1u, 2u, 10u, 100u, 1000u, 10000u}) {
+    std::vector<K> sorted(size);
+    for (K& x : sorted) x = gen(g);
+    std::sort(sorted.begin(), sorted.end());
+
+    for (std::size_t epsilon : {1u, 4u, 32u}) {
+      srt::learned_index<K> index(sorted.begin(), sorted.end(), epsilon);
+      REQUIRE(std::equal(index.begin(), index.end(), sorted.begin(),
+                         sorted.end()));
+      REQUIRE(index.stats().segments <= size);
+      REQUIRE(index.stats().mean_error <=
+              static_cast<double>(index.stats().max_error));
+      // The model is fit exactly on the first positions, rounding down
+      // can cost one more.
+      REQUIRE(index.stats().max_error <= epsilon + 1);
+
+      std::vector<K> needles = sorted;
+      for (std::size_t i = 0; i != size / 2 + 3; ++i) needles.push_back(gen(g));
+
+      for (K v : needles) {
+        auto lb = std::lower_bound(sorted.begin(), sorted.end(), v) - sorted.begin();
+        auto ub = std::upper_bound(sorted.begin(), sorted.end(), v) - sorted.begin();
+        REQUIRE(index.lower_bound(v) - index.begin() == lb);
+        REQUIRE(index.upper_bound(v) - index.begin() == ub);
+        auto r = index.equal_range(v);
+        REQUIRE(r.first - index.begin() == lb);
+        REQUIRE(r.second - index.begin() == ub);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("learned_index", "[learned_index]") {
+  test_learned_index<std::int64_t>([](std::mt19937& g) {
+    return std::uniform_int_distribution<std::int64_t>(-1000000, 1000000)(g);
+  });
+  // Lots of duplicates.
+  test_learned_index<int>(
+      [](std::mt19937& g) { return std::uniform_int_distribution<int>(0, 50)(g); });
+  test_learned_index<double>(
+      [](std::mt19937& g) { return std::lognormal_distribution<double>(0, 2)(g); });
+  test_learned_index<std::uint64_t>([](std::mt19937& g) {
+    return std::uniform_int_distribution<std::uint64_t>(
+        0, std::numeric_limits<std::uint64_t>::max())(g);
+  });
+}
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "result.h"
+
+namespace {
+
+constexpr std::size_t kRunSize = 1000000u;
+
+enum interleaving : int { kRandom, kBlocky, kDisjoint };
+
+// Two sorted runs of kRunSize, one after the other.
+const std::vector<std::int64_t>& two_runs(interleaving kind) {
+  static std::vector<std::int64_t> res;
+  static int res_kind = -1;
+  if (res_kind == kind) return res;
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(0, 1000000000);
+  std::uniform_int_distribution<std::int64_t> coin(0, 1);
+
+  res.resize(kRunSize * 2);
+  switch (kind) {
+    case kRandom:
+      for (auto& x : res) x = dis(g);
+      break;
+    case kBlocky: {
+      // Blocks of 1000 go to one of the runs.
+      std::int64_t key = 0;
+      auto to_first = res.begin();
+      auto to_second = res.begin() + kRunSize;
+      while (to_first != res.begin() + kRunSize &&
+             to_second != res.end()) {
+        auto& to = coin(g) ? to_first : to_second;
+        for (int i = 0; i < 1000; ++i) *to++ = key++;
+      }
+      std::iota(to_first, res.begin() + kRunSize, key);
+      std::iota(to_second, res.end(), key);
+      break;
+    }
+    case kDisjoint:
+      std::iota(res.begin() + kRunSize, res.end(), 0);
+      std::iota(res.begin(), res.begin() + kRunSize,
+                static_cast<std::int64_t>(kRunSize));
+      break;
+  }
+  std::sort(res.begin(), res.begin() + kRunSize);
+  std::sort(res.begin() + kRunSize, res.end());
+
+  res_kind = kind;
+  return res;
+}
+
+void set_interleaving(benchmark::internal::Benchmark* bench) {
+  bench->Arg(kRandom)->Arg(kBlocky)->Arg(kDisjoint);
+}
+
+struct std_merge {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return std::merge(f1, l1, f2, l2, out);
+  }
+};
+
+struct biased_merge {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return srt::merge_biased(f1, l1, f2, l2, out);
+  }
+};
+
+struct std_inplace_merge {
+  template <typename I>
+  void operator()(I f, I m, I l) {
+    std::inplace_merge(f, m, l);
+  }
+};
+
+struct biased_inplace_merge {
+  template <typename I>
+  void operator()(I f, I m, I l) {
+    srt::inplace_merge_biased(f, m, l);
+  }
+};
+
+}  // namespace
+
+template <typename Alg>
+void benchmark_merge(benchmark::State& state) {
+  const auto& input = two_runs(static_cast<interleaving>(state.range(0)));
+  std::vector<std::int64_t> out(input.size());
+  auto m = input.begin() + kRunSize;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Alg{}(input.begin(), m, m, input.end(), out.begin()));
+    benchmark::ClobberMemory();
+  }
+}
+
+template <typename Alg>
+void benchmark_inplace_merge(benchmark::State& state) {
+  const auto& input = two_runs(static_cast<interleaving>(state.range(0)));
+  std::vector<std::int64_t> buf;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    buf = input;
+    state.ResumeTiming();
+
+    Alg{}(buf.begin(), buf.begin() + kRunSize, buf.end());
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK_TEMPLATE(benchmark_merge, std_merge)->Apply(set_interleaving);
+BENCHMARK_TEMPLATE(benchmark_merge, biased_merge)->Apply(set_interleaving);
+BENCHMARK_TEMPLATE(benchmark_inplace_merge, std_inplace_merge)->Apply(set_interleaving);
+BENCHMARK_TEMPLATE(benchmark_inplace_merge, biased_inplace_merge)->Apply(set_interleaving);
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+
+namespace srt {
+
+// Streaming inner join of two sorted inputs on a key.
+//
+// Inputs are readers: callables that fill a buffer with up to n records
+// and return how many they wrote, 0 at the end:
+//
+//   std::size_t read(Record* out, std::size_t n);
+//
+// Each side is read in blocks of block_size records into a buffer of
+// block_size + 1, the buffers are all the memory the join uses. Inside a
+// block, records that can't match are skipped with lower_bound_biased,
+// so a sparse side costs O(m log(n / m)) comparisons, not O(n + m).
+//
+// For every key found on both sides, join(left, right) is called with
+// range_pairs of the equal records: spans into the buffers, valid only
+// for the call, nothing is copied. If a group of equal records is longer
+// than what is left of its buffer, it is passed in several pieces, each
+// with the whole group of the other side, so the calls together still
+// cover every pair. Groups longer than block_size on both sides can't be
+// joined without spilling to disk: that throws std::length_error.
+//
+// p compares records from either side with each other.
+
+namespace merge_join_detail {
+
+template <typename Record, typename Read>
+class block_cursor {
+  Read read_;
+  std::vector<Record> buf_;
+  std::size_t pos_ = 0;
+  std::size_t end_ = 0;
+  bool eof_ = false;
+
+ public:
+  // One record more than the block, to see where a group of block_size
+  // records ends.
+  block_cursor(Read read, std::size_t block_size)
+      : read_(std::move(read)), buf_(block_size + 1) {}
+
+  const Record* pos() const { return buf_.data() + pos_; }
+  const Record* end() const { return buf_.data() + end_; }
+  bool full_from_start() const { return pos_ == 0 && end_ == buf_.size(); }
+
+  void seek(const Record* pos) {
+    pos_ = static_cast<std::size_t>(pos - buf_.data());
+  }
+
+  // Keeps [pos, end), moved to the front, and reads to fill the rest.
+  // Returns false if nothing was read.
+  bool refill() {
+    if (eof_) return false;
+    std::move(buf_.begin() + static_cast<std::ptrdiff_t>(pos_),
+              buf_.begin() + static_cast<std::ptrdiff_t>(end_), buf_.begin());
+    end_ -= pos_;
+    pos_ = 0;
+    std::size_t read = read_(buf_.data() + end_, buf_.size() - end_);
+    if (read == 0) eof_ = true;
+    end_ += read;
+    return read != 0;
+  }
+
+  // *pos() is less than v. Skips to the first record not less than v,
+  // refilling on the way. Returns false at the end of the input.
+  template <typename V, typename P>
+  bool skip_to(const V& v, P p) {
+    seek(pos() + 1);
+    // Dense inputs: the next record is often the answer.
+    if (pos() != end() && !p(*pos(), v)) return true;
+    while (true) {
+      seek(lower_bound_biased(pos(), end(), v, p));
+      if (pos() != end()) return true;
+      if (!refill()) return false;
+    }
+  }
+
+  bool at_end() {
+    while (pos() == end())
+      if (!refill()) return true;
+    return false;
+  }
+
+  // End of the records equal to v = *pos() that are in the buffer.
+  // Refills while the buffer has room, so on return either the whole
+  // group is in [pos(), result) or it fills the buffer.
+  template <typename P>
+  const Record* extend_group(const Record& v, P p) {
+    // Groups of one are the common case.
+    if (end() - pos() >= 2 && p(v, pos()[1])) return pos() + 1;
+    const Record* res = upper_bound_biased(pos(), end(), v, p);
+    while (res == end() && !full_from_start()) {
+      auto offset = res - pos();
+      bool more = refill();
+      res = pos() + offset;  // refill moved the records
+      if (!more) break;
+      res = upper_bound_biased(res, end(), v, p);
+    }
+    return res;
+  }
+
+  // Whether the group ending at group_end is all there is.
+  bool complete(const Record* group_end) const {
+    return group_end != end() || eof_;
+  }
+
+  // Drops the buffer and reads the next piece of the group of v.
+  // Returns the end of the piece, pos() if the group is over.
+  template <typename P>
+  const Record* next_piece(const Record& v, P p) {
+    seek(end());
+    refill();
+    return upper_bound_biased(pos(), end(), v, p);
+  }
+};
+
+// Calls join for every piece of the incomplete group in c, with the
+// whole group in the other side. Leaves c after the group.
+template <bool CursorIsLeft, typename Cursor, typename Record, typename Other,
+          typename P, typename F>
+void join_pieces(Cursor& c, const Record* piece_end, const Record& v,
+                 const range_pair<Other>& other, P p, F& join) {
+  while (true) {
+    range_pair<const Record*> piece{c.pos(), piece_end};
+    if (piece.begin() == piece.end()) break;
+    if (CursorIsLeft)
+      join(piece, other);
+    else
+      join(other, piece);
+    bool done = c.complete(piece_end);
+    c.seek(piece_end);
+    if (done) break;
+    piece_end = c.next_piece(v, p);
+  }
+}
+
+}  // namespace merge_join_detail
+
+template <typename Record1, typename Record2, typename Read1, typename Read2,
+          typename F, typename P>
+// requires Reader<Read1, Record1> && Reader<Read2, Record2> &&
+//          StrictWeakOrder<P(Record1, Record2)> &&
+//          Invocable<F(range_pair<const Record1*>, range_pair<const Record2*>)>
+void merge_join(Read1 read1, Read2 read2, std::size_t block_size, F join,
+                P p) {
+  using namespace merge_join_detail;
+  block_cursor<Record1, Read1> left(std::move(read1), block_size);
+  block_cursor<Record2, Read2> right(std::move(read2), block_size);
+
+  while (!left.at_end() && !right.at_end()) {
+    if (p(*left.pos(), *right.pos())) {
+      if (!left.skip_to(*right.pos(), p)) return;
+      continue;
+    }
+    if (p(*right.pos(), *left.pos())) {
+      if (!right.skip_to(*left.pos(), p)) return;
+      continue;
+    }
+
+    // The buffers move when refilled, so the key is kept by value.
+    const Record1 v1 = *left.pos();
+    const Record2 v2 = *right.pos();
+    const Record1* left_end = left.extend_group(v1, p);
+    const Record2* right_end = right.extend_group(v2, p);
+
+    if (left.complete(left_end)) {
+      range_pair<const Record1*> group{left.pos(), left_end};
+      join_pieces<false>(right, right_end, v2, group, p, join);
+      left.seek(left_end);
+    } else if (right.complete(right_end)) {
+      range_pair<const Record2*> group{right.pos(), right_end};
+      join_pieces<true>(left, left_end, v1, group, p, join);
+      right.seek(right_end);
+    } else {
+      throw std::length_error(
+          "merge_join: equal keys on both sides overflow the block size");
+    }
+  }
+}
+
+template <typename Record1, typename Record2, typename Read1, typename Read2,
+          typename F>
+// requires Reader<Read1, Record1> && Reader<Read2, Record2> &&
+//          WeakComarable<Record1, Record2> &&
+//          Invocable<F(range_pair<const Record1*>, range_pair<const Record2*>)>
+void merge_join(Read1 read1, Read2 read2, std::size_t block_size, F join) {
+  merge_join<Record1, Record2>(std::move(read1), std::move(read2), block_size,
+                               std::move(join), less{});
+}
+
+// Reads records from [f, l).
+template <typename I>
+// requires InputIterator<I>
+class range_reader {
+  I f_;
+  I l_;
+
+ public:
+  range_reader(I f, I l) : f_(f), l_(l) {}
+
+  template <typename Record>
+  std::size_t operator()(Record* out, std::size_t n) {
+    std::size_t res = 0;
+    for (; res != n && f_ != l_; ++f_, ++res) out[res] = *f_;
+    return res;
+  }
+};
+
+template <typename I>
+range_reader<I> make_range_reader(I f, I l) {
+  return {f, l};
+}
+
+// Reads records from a file descriptor: a file or a pipe. Doesn't own
+// it. Errors throw std::system_error, a truncated record at the end
+// std::runtime_error.
+class fd_reader {
+  int fd_;
+
+ public:
+  explicit fd_reader(int fd) : fd_(fd) {}
+
+  template <typename Record>
+  std::size_t operator()(Record* out, std::size_t n) {
+    static_assert(std::is_trivially_copyable<Record>::value,
+                  "records are read as bytes");
+    char* bytes = reinterpret_cast<char*>(out);
+    std::size_t want = n * sizeof(Record);
+    std::size_t got = 0;
+    // Pipes return what they have, keep reading to whole records.
+    while (got != want) {
+      ssize_t read = ::read(fd_, bytes + got, want - got);
+      if (read == -1) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(),
+                                "fd_reader: read");
+      }
+      if (read == 0) break;
+      got += static_cast<std::size_t>(read);
+      if (got % sizeof(Record) == 0) break;
+    }
+    if (got % sizeof(Record) != 0)
+      throw std::runtime_error("fd_reader: truncated record");
+    return got / sizeof(Record);
+  }
+};
+
+}  // namespace srt
@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "merge_join.h"
+
+namespace {
+
+constexpr std::size_t kLeftSize = 1u << 24;
+constexpr std::size_t kBlockSize = 1u << 14;
+
+struct record {
+  std::int64_t key;
+  std::int64_t payload;
+};
+
+struct by_key {
+  bool operator()(const record& x, const record& y) const {
+    return x.key < y.key;
+  }
+};
+
+const std::vector<record>& left_records() {
+  static const std::vector<record> res = [] {
+    std::vector<record> res(kLeftSize);
+    for (std::size_t i = 0; i != res.size(); ++i)
+      res[i] = {static_cast<std::int64_t>(i) * 2, static_cast<std::int64_t>(i)};
+    return res;
+  }();
+  return res;
+}
+
+// range(0) per mille of the left size, half of them match.
+std::vector<record> right_records(benchmark::State& state) {
+  std::mt19937 g;
+  auto size = kLeftSize / 1000 * static_cast<std::size_t>(state.range(0));
+  std::uniform_int_distribution<std::int64_t> dis(0, kLeftSize * 2);
+  std::vector<record> res(size);
+  for (std::size_t i = 0; i != size; ++i)
+    res[i] = {dis(g), static_cast<std::int64_t>(i)};
+  std::sort(res.begin(), res.end(), by_key{});
+  return res;
+}
+
+void set_density(benchmark::internal::Benchmark* bench) {
+  for (int per_mille : {1, 10, 100, 1000}) bench->Arg(per_mille);
+  bench->Unit(benchmark::kMillisecond);
+}
+
+// Reads a block at a time and hands out one record at a time.
+template <typename Read>
+class naive_cursor {
+  Read read_;
+  std::vector<record> buf_;
+  std::size_t pos_ = 0;
+  std::size_t end_ = 0;
+
+ public:
+  naive_cursor(Read read, std::size_t block_size)
+      : read_(read), buf_(block_size) {}
+
+  const record* peek() {
+    if (pos_ == end_) {
+      pos_ = 0;
+      end_ = read_(buf_.data(), buf_.size());
+      if (end_ == 0) return nullptr;
+    }
+    return &buf_[pos_];
+  }
+
+  void next() { ++pos_; }
+};
+
+// The textbook join: one comparison per record on both sides. Right
+// keys are unique in practice, so every match is a single pair.
+template <typename Read1, typename Read2, typename F>
+void naive_merge_join(Read1 read1, Read2 read2, F join) {
+  naive_cursor<Read1> left(read1, kBlockSize);
+  naive_cursor<Read2> right(read2, kBlockSize);
+  const record* x = left.peek();
+  const record* y = right.peek();
+  while (x && y) {
+    if (x->key < y->key) {
+      left.next();
+      x = left.peek();
+    } else if (y->key < x->key) {
+      right.next();
+      y = right.peek();
+    } else {
+      join(*x, *y);
+      right.next();
+      y = right.peek();
+    }
+  }
+}
+
+}  // namespace
+
+void benchmark_naive_merge_join(benchmark::State& state) {
+  const auto& left = left_records();
+  const auto right = right_records(state);
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    naive_merge_join(srt::make_range_reader(left.begin(), left.end()),
+                     srt::make_range_reader(right.begin(), right.end()),
+                     [&](const record& x, const record& y) {
+                       sum += x.payload + y.payload;
+                     });
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+void benchmark_srt_merge_join(benchmark::State& state) {
+  const auto& left = left_records();
+  const auto right = right_records(state);
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    srt::merge_join<record, record>(
+        srt::make_range_reader(left.begin(), left.end()),
+        srt::make_range_reader(right.begin(), right.end()), kBlockSize,
+        [&](srt::range_pair<const record*> xs,
+            srt::range_pair<const record*> ys) {
+          for (const auto& x : xs)
+            for (const auto& y : ys) sum += x.payload + y.payload;
+        },
+        by_key{});
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+BENCHMARK(benchmark_naive_merge_join)->Apply(set_density);
+BENCHMARK(benchmark_srt_merge_join)->Apply(set_density);
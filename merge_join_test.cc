@@ -0,0 +1,154 @@
+#include "merge_join.h"
+#include "third_party/catch.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct record {
+  int key;
+  int payload;
+};
+
+struct by_key {
+  template <typename X, typename Y>
+  bool operator()(const X& x, const Y& y) const {
+    return x.key < y.key;
+  }
+};
+
+using payload_pairs = std::vector<std::pair<int, int>>;
+
+std::vector<record> random_records(std::mt19937& g, std::size_t size,
+                                   int max_key) {
+  std::uniform_int_distribution<int> dis(0, max_key);
+  std::vector<record> res(size);
+  for (std::size_t i = 0; i != size; ++i)
+    res[i] = {dis(g), static_cast<int>(i)};
+  std::stable_sort(res.begin(), res.end(), by_key{});
+  return res;
+}
+
+payload_pairs expected_join(const std::vector<record>& left,
+                            const std::vector<record>& right) {
+  payload_pairs res;
+  for (const auto& x : left)
+    for (const auto& y : right)
+      if (x.key == y.key) res.emplace_back(x.payload, y.payload);
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+// The shorter group of the longest key found on both sides.
+std::size_t longest_common_group(const std::vector<record>& left,
+                                 const std::vector<record>& right) {
+  std::size_t res = 0;
+  for (const auto& x : left) {
+    auto in_left = std::equal_range(left.begin(), left.end(), x, by_key{});
+    auto in_right = std::equal_range(right.begin(), right.end(), x, by_key{});
+    res = std::max(res, static_cast<std::size_t>(std::min(
+                            in_left.second - in_left.first,
+                            in_right.second - in_right.first)));
+  }
+  return res;
+}
+
+payload_pairs join(const std::vector<record>& left,
+                   const std::vector<record>& right, std::size_t block_size) {
+  payload_pairs res;
+  srt::merge_join<record, record>(
+      srt::make_range_reader(left.begin(), left.end()),
+      srt::make_range_reader(right.begin(), right.end()), block_size,
+      [&](srt::range_pair<const record*> xs,
+          srt::range_pair<const record*> ys) {
+        REQUIRE(xs.begin() != xs.end());
+        REQUIRE(ys.begin() != ys.end());
+        for (const auto& x : xs)
+          for (const auto& y : ys) {
+            REQUIRE(x.key == y.key);
+            res.emplace_back(x.payload, y.payload);
+          }
+      },
+      by_key{});
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+}  // namespace
+
+TEST_CASE("merge_join", "[merge_join]") {
+  std::mt19937 g;
+
+  for (std::size_t left_size : {0, 1, 10, 300}) {
+    for (std::size_t right_size : {0, 1, 3, 50, 300}) {
+      for (int max_key : {5, 100, 10000}) {
+        auto left = random_records(g, left_size, max_key);
+        auto right = random_records(g, right_size, max_key);
+        auto expected = expected_join(left, right);
+
+        for (std::size_t block_size : {1, 8, 64, 1000}) {
+          if (longest_common_group(left, right) > block_size) {
+            REQUIRE_THROWS_AS(join(left, right, block_size), std::length_error);
+            continue;
+          }
+          REQUIRE(join(left, right, block_size) == expected);
+          REQUIRE(join(right, left, block_size).size() == expected.size());
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("merge_join_long_groups", "[merge_join]") {
+  // A group much longer than the block against a short one, and the
+  // other way around.
+  std::vector<record> left;
+  for (int i = 0; i != 100; ++i) left.push_back({1, i});
+  left.push_back({2, 100});
+  std::vector<record> right = {{0, 0}, {1, 1}, {1, 2}, {2, 3}};
+
+  auto expected = expected_join(left, right);
+  REQUIRE(expected.size() == 201);
+  for (std::size_t block_size : {2, 3, 7, 100, 101}) {
+    REQUIRE(join(left, right, block_size) == expected);
+    REQUIRE(join(right, left, block_size).size() == expected.size());
+  }
+
+  REQUIRE_THROWS_AS(join(left, right, 1), std::length_error);
+  REQUIRE_THROWS_AS(join(left, left, 99), std::length_error);
+  REQUIRE(join(left, left, 100).size() == 100 * 100 + 1);
+}
+
+TEST_CASE("merge_join_pipe", "[merge_join]") {
+  std::vector<std::int64_t> left;
+  for (std::int64_t i = 0; i != 3000; ++i) left.push_back(i);
+  std::vector<std::int64_t> right = {-1, 5, 5, 2999, 3000};
+
+  int fds[2];
+  REQUIRE(::pipe(fds) == 0);
+  REQUIRE(::write(fds[1], left.data(), left.size() * sizeof(left[0])) ==
+          static_cast<ssize_t>(left.size() * sizeof(left[0])));
+  ::close(fds[1]);
+
+  std::vector<std::int64_t> matches;
+  srt::merge_join<std::int64_t, std::int64_t>(
+      srt::fd_reader(fds[0]),
+      srt::make_range_reader(right.begin(), right.end()), 256,
+      [&](srt::range_pair<const std::int64_t*> xs,
+          srt::range_pair<const std::int64_t*> ys) {
+        for (auto x : xs)
+          for (auto y : ys) {
+            REQUIRE(x == y);
+            matches.push_back(x);
+          }
+      });
+  ::close(fds[0]);
+  REQUIRE(matches == std::vector<std::int64_t>{5, 5, 2999});
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "result.h"
+
+namespace srt {
+
+struct identity {
+  template <typename T>
+  constexpr const T& operator()(const T& x) const noexcept {
+    return x;
+  }
+};
+
+// Compares records and keys, in any mix, by KeyFn(record).
+template <typename Record, typename KeyFn>
+class record_key_compare {
+  KeyFn key_fn_;
+
+  decltype(auto) key(const Record& x, std::true_type /*is record*/) {
+    return key_fn_(x);
+  }
+
+  template <typename X>
+  const X& key(const X& x, std::false_type /*is record*/) {
+    return x;
+  }
+
+ public:
+  explicit record_key_compare(KeyFn key_fn = KeyFn{}) : key_fn_(key_fn) {}
+
+  template <typename X, typename Y>
+  // requires X, Y are Record or the key type
+  bool operator()(const X& x, const Y& y) {
+    return less{}(key(x, std::is_same<X, Record>{}),
+                  key(y, std::is_same<Y, Record>{}));
+  }
+};
+
+// A read-only file of sorted fixed-width records, mapped into memory.
+// The iterators are plain pointers into the mapping, so every search in
+// this library runs on it as is, nothing is copied:
+//
+//   srt::mmap_sorted_array<record, by_id> index("records.bin");
+//   auto it = srt::lower_bound_biased(index.begin(), index.end(), id,
+//                                     index.key_comp());
+//
+// KeyFn maps a record to its key. key_comp() compares any mix of records
+// and keys through it.
+//
+// POSIX only. Errors from the system throw std::system_error.
+
+template <typename Record, typename KeyFn = identity>
+class mmap_sorted_array {
+  static_assert(std::is_trivially_copyable<Record>::value,
+                "records are read straight from the file");
+
+  const Record* data_ = nullptr;
+  std::size_t size_ = 0;
+  KeyFn key_fn_;
+
+  std::size_t mapped_bytes() const { return size_ * sizeof(Record); }
+
+  static std::size_t page_size() {
+    static const std::size_t res =
+        static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return res;
+  }
+
+  void unmap() {
+    if (data_)
+      ::munmap(const_cast<Record*>(data_), mapped_bytes());
+  }
+
+ public:
+  using value_type = Record;
+  using iterator = const Record*;
+  using const_iterator = iterator;
+  using key_type = std::decay_t<decltype(
+      std::declval<KeyFn&>()(std::declval<const Record&>()))>;
+
+  enum class access {
+    normal,
+    random,      // no readahead: point lookups in a large file
+    sequential,  // aggressive readahead: scans
+    will_need,   // start reading the whole file in the background
+  };
+
+  using key_compare = record_key_compare<Record, KeyFn>;
+
+  mmap_sorted_array() = default;
+
+  explicit mmap_sorted_array(const std::string& path, KeyFn key_fn = KeyFn{})
+      : key_fn_(key_fn) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+      throw std::system_error(errno, std::generic_category(),
+                              "mmap_sorted_array: open " + path);
+
+    struct stat st;
+    if (::fstat(fd, &st) == -1) {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(),
+                              "mmap_sorted_array: fstat " + path);
+    }
+    auto bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes % sizeof(Record) != 0) {
+      ::close(fd);
+      throw std::runtime_error("mmap_sorted_array: the size of " + path +
+                               " is not a multiple of the record size");
+    }
+
+    // mmap refuses empty mappings, an empty file is an empty array.
+    if (bytes != 0) {
+      void* mem = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+      if (mem == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(),
+                                "mmap_sorted_array: mmap " + path);
+      }
+      data_ = static_cast<const Record*>(mem);
+      size_ = bytes / sizeof(Record);
+    }
+    // The mapping keeps the file alive.
+    ::close(fd);
+  }
+
+  mmap_sorted_array(const mmap_sorted_array&) = delete;
+  mmap_sorted_array& operator=(const mmap_sorted_array&) = delete;
+
+  mmap_sorted_array(mmap_sorted_array&& x) noexcept
+      : data_(x.data_), size_(x.size_), key_fn_(x.key_fn_) {
+    x.data_ = nullptr;
+    x.size_ = 0;
+  }
+
+  mmap_sorted_array& operator=(mmap_sorted_array&& x) noexcept {
+    swap(x);
+    return *this;
+  }
+
+  ~mmap_sorted_array() { unmap(); }
+
+  void swap(mmap_sorted_array& x) noexcept {
+    using std::swap;
+    swap(data_, x.data_);
+    swap(size_, x.size_);
+    swap(key_fn_, x.key_fn_);
+  }
+
+  iterator begin() const { return data_; }
+  iterator end() const { return data_ + size_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const Record& operator[](std::size_t i) const { return data_[i]; }
+
+  key_compare key_comp() const { return key_compare(key_fn_); }
+
+  // A hint to the kernel for the whole mapping, it may be ignored.
+  void advise(access a) const {
+    if (empty()) return;
+    int advice = a == access::random       ? MADV_RANDOM
+                 : a == access::sequential ? MADV_SEQUENTIAL
+                 : a == access::will_need  ? MADV_WILLNEED
+                                           : MADV_NORMAL;
+    ::madvise(const_cast<Record*>(data_), mapped_bytes(), advice);
+  }
+
+  // Asks the kernel to start reading the pages that a biased search in
+  // [f, l) is going to touch: the middle, then f + 2^i. On a cold file
+  // these are read in parallel, instead of one page fault at a time.
+  // Costs a system call per page, only worth it when pages are likely
+  // not in memory.
+  void prefetch_biased(iterator f, iterator l) const {
+    if (f == l) return;
+    prefetch_page(f + (l - f) / 2);
+    for (std::ptrdiff_t step = 1; step < l - f; step += step)
+      prefetch_page(f + step);
+  }
+
+  void prefetch_page(iterator it) const {
+    auto addr = reinterpret_cast<std::uintptr_t>(it);
+    addr -= addr % page_size();
+    ::madvise(reinterpret_cast<void*>(addr), page_size(), MADV_WILLNEED);
+  }
+
+  template <typename K>
+  // requires K is key_type or Record
+  iterator lower_bound(const K& k) const {
+    return lower_bound_n(begin(), static_cast<std::ptrdiff_t>(size_), k,
+                         key_comp());
+  }
+
+  template <typename K>
+  // requires K is key_type or Record
+  iterator upper_bound(const K& k) const {
+    return upper_bound_n(begin(), static_cast<std::ptrdiff_t>(size_), k,
+                         key_comp());
+  }
+
+  template <typename K>
+  // requires K is key_type or Record
+  std::pair<iterator, iterator> equal_range(const K& k) const {
+    return equal_range_n(begin(), static_cast<std::ptrdiff_t>(size_), k,
+                         key_comp());
+  }
+
+  template <typename K>
+  // requires K is key_type or Record
+  bool contains(const K& k) const {
+    iterator it = lower_bound(k);
+    return it != end() && !key_comp()(k, *it);
+  }
+};
+
+}  // namespace srt
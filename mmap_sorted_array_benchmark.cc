@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mmap_sorted_array.h"
+
+namespace {
+
+// 64MB of 16 byte records.
+constexpr std::size_t kRecordsCount = 1u << 22;
+constexpr std::size_t kQueriesCount = 1u << 16;
+constexpr std::size_t kColdLookups = 1000;
+
+struct record {
+  std::int64_t key;
+  std::int64_t payload;
+};
+
+struct by_key {
+  std::int64_t operator()(const record& r) const { return r.key; }
+};
+
+using index_type = srt::mmap_sorted_array<record, by_key>;
+
+const std::string& file_path() {
+  static const std::string path = [] {
+    std::string res = "/tmp/mmap_sorted_array_benchmark.bin";
+    std::vector<record> records(kRecordsCount);
+    for (std::size_t i = 0; i != records.size(); ++i)
+      records[i] = {static_cast<std::int64_t>(i) * 3,
+                    static_cast<std::int64_t>(i)};
+    std::ofstream out(res, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(record)));
+    return res;
+  }();
+  return path;
+}
+
+// Drops the file from the page cache, the next access reads the disk.
+void evict_file() {
+  int fd = ::open(file_path().c_str(), O_RDONLY);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+}
+
+std::vector<record> load_file() {
+  std::vector<record> res(kRecordsCount);
+  std::ifstream in(file_path(), std::ios::binary);
+  in.read(reinterpret_cast<char*>(res.data()),
+          static_cast<std::streamsize>(res.size() * sizeof(record)));
+  return res;
+}
+
+std::vector<std::int64_t> queries(std::size_t count) {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(0, kRecordsCount * 3);
+  std::vector<std::int64_t> res(count);
+  for (auto& x : res) x = dis(g);
+  return res;
+}
+
+template <typename Searcher>
+void run_lookups(benchmark::State& state, Searcher searcher) {
+  const auto qs = queries(kQueriesCount);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(searcher(qs[i]));
+    i = (i + 1) % qs.size();
+  }
+}
+
+}  // namespace
+
+// Warm: everything is in memory.
+
+void benchmark_warm_lookup_vector(benchmark::State& state) {
+  const auto records = load_file();
+  run_lookups(state, [&](std::int64_t v) {
+    return srt::lower_bound_n(records.begin(),
+                              static_cast<std::ptrdiff_t>(records.size()), v,
+                              index_type::key_compare{});
+  });
+}
+
+void benchmark_warm_lookup_mmap(benchmark::State& state) {
+  const index_type index(file_path());
+  index.advise(index_type::access::will_need);
+  run_lookups(state, [&](std::int64_t v) { return index.lower_bound(v); });
+}
+
+// Cold: from a file not in the page cache to kColdLookups answers.
+
+void benchmark_cold_lookups_vector(benchmark::State& state) {
+  const auto qs = queries(kColdLookups);
+  for (auto _ : state) {
+    state.PauseTiming();
+    evict_file();
+    state.ResumeTiming();
+
+    const auto records = load_file();
+    for (auto q : qs)
+      benchmark::DoNotOptimize(srt::lower_bound_n(
+          records.begin(), static_cast<std::ptrdiff_t>(records.size()), q,
+          index_type::key_compare{}));
+  }
+}
+
+// range(0): madvise(MADV_RANDOM), range(1): prefetch_biased before each
+// search.
+void benchmark_cold_lookups_mmap(benchmark::State& state) {
+  const auto qs = queries(kColdLookups);
+  const bool random = state.range(0) != 0;
+  const bool prefetch = state.range(1) != 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    evict_file();
+    state.ResumeTiming();
+
+    const index_type index(file_path());
+    if (random) index.advise(index_type::access::random);
+    for (auto q : qs) {
+      if (prefetch) index.prefetch_biased(index.begin(), index.end());
+      benchmark::DoNotOptimize(srt::lower_bound_biased(
+          index.begin(), index.end(), q, index.key_comp()));
+    }
+  }
+}
+
+BENCHMARK(benchmark_warm_lookup_vector);
+BENCHMARK(benchmark_warm_lookup_mmap);
+BENCHMARK(benchmark_cold_lookups_vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmark_cold_lookups_mmap)
+    ->Args({0, 0})
+    ->Args({0, 1})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Unit(benchmark::kMillisecond);
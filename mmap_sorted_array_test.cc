@@ -0,0 +1,114 @@
+#include "mmap_sorted_array.h"
+#include "third_party/catch.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+struct record {
+  std::int64_t key;
+  std::int64_t payload;
+};
+
+struct by_key {
+  std::int64_t operator()(const record& r) const { return r.key; }
+};
+
+template <typename T>
+std::string write_file(const std::vector<T>& xs) {
+  char path[] = "/tmp/mmap_sorted_array_testXXXXXX";
+  int fd = ::mkstemp(path);
+  REQUIRE(fd != -1);
+  std::size_t bytes = xs.size() * sizeof(T);
+  REQUIRE(::write(fd, xs.data(), bytes) == static_cast<ssize_t>(bytes));
+  ::close(fd);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("mmap_sorted_array", "[mmap_sorted_array]") {
+  std::mt19937 g;
+
+  for (std::size_t size : {0, 1, 2, 5, 100, 3000}) {
+    std::uniform_int_distribution<std::int64_t> dis(0, size);
+    std::vector<record> records(size);
+    for (auto& r : records) r = {dis(g), dis(g)};
+    std::sort(records.begin(), records.end(),
+              [](const record& x, const record& y) { return x.key < y.key; });
+    std::vector<std::int64_t> keys;
+    for (const auto& r : records) keys.push_back(r.key);
+
+    const std::string path = write_file(records);
+    srt::mmap_sorted_array<record, by_key> index(path);
+    std::remove(path.c_str());  // the mapping keeps the file around
+
+    REQUIRE(index.size() == size);
+    for (std::size_t i = 0; i != size; ++i) {
+      REQUIRE(index[i].key == records[i].key);
+      REQUIRE(index[i].payload == records[i].payload);
+    }
+    index.advise(decltype(index)::access::random);
+
+    for (std::int64_t v = -1; v <= static_cast<std::int64_t>(size) + 1; ++v) {
+      auto lb = std::lower_bound(keys.begin(), keys.end(), v) - keys.begin();
+      auto ub = std::upper_bound(keys.begin(), keys.end(), v) - keys.begin();
+      auto f = index.begin();
+      auto l = index.end();
+      auto n = l - f;
+      auto comp = index.key_comp();
+
+      REQUIRE(index.lower_bound(v) - f == lb);
+      REQUIRE(index.upper_bound(v) - f == ub);
+      REQUIRE(index.equal_range(v) == std::make_pair(f + lb, f + ub));
+      REQUIRE(index.contains(v) == (lb != ub));
+
+      REQUIRE(srt::lower_bound_n(f, n, v, comp) - f == lb);
+      REQUIRE(srt::upper_bound_biased(f, l, v, comp) - f == ub);
+      REQUIRE(srt::equal_range_biased(f, l, v, comp) ==
+              std::make_pair(f + lb, f + ub));
+      REQUIRE(srt::lower_bound_hinted(f, f + n / 3, l, v, comp) - f == lb);
+
+      index.prefetch_biased(f, l);
+      REQUIRE(srt::lower_bound_biased(f, l, v, comp) - f == lb);
+
+      if (lb != n) REQUIRE(index.lower_bound(index[lb]) - f == lb);
+    }
+  }
+}
+
+TEST_CASE("mmap_sorted_array_keys", "[mmap_sorted_array]") {
+  std::vector<std::int64_t> keys = {1, 3, 3, 7};
+  const std::string path = write_file(keys);
+  srt::mmap_sorted_array<std::int64_t> index(path);
+  std::remove(path.c_str());
+
+  REQUIRE(index.lower_bound(3) - index.begin() == 1);
+  REQUIRE(index.upper_bound(3) - index.begin() == 3);
+  REQUIRE(!index.contains(4));
+
+  srt::mmap_sorted_array<std::int64_t> moved = std::move(index);
+  REQUIRE(index.empty());
+  REQUIRE(moved.size() == keys.size());
+  REQUIRE(moved.contains(7));
+}
+
+TEST_CASE("mmap_sorted_array_errors", "[mmap_sorted_array]") {
+  using index = srt::mmap_sorted_array<std::int64_t>;
+  REQUIRE_THROWS_AS(index("/nonexistent/mmap_sorted_array"),
+                    std::system_error);
+
+  const std::string path = write_file(std::vector<char>{'a', 'b', 'c'});
+  REQUIRE_THROWS_AS(index(path), std::runtime_error);
+  std::remove(path.c_str());
+}
@@ -1,9 +1,13 @@
 #include "other_algorithms.h"
 #include "third_party/catch.h"
 
+#include <cstdint>
 #include <forward_list>
+#include <limits>
 #include <list>
 #include <numeric>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include <random>
@@ -152,6 +156,346 @@ TEST_CASE("equal_range_biased", "[blog_post]") {
 
 // ----------------------------------------------
 
+namespace {
+
+template <typename C>
+void test_biased_batch(const C& haystack) {
+  using I = typename C::const_iterator;
+
+  std::vector<int> all_needles;
+  for (int i = -1; i < 12; ++i) {
+    all_needles.push_back(i);
+    if (i % 3 == 0) all_needles.push_back(i);
+  }
+
+  for (auto nl = all_needles.begin(); nl != all_needles.end(); ++nl) {
+    for (auto nf = all_needles.begin(); nf != nl; ++nf) {
+      auto f = haystack.begin();
+      auto l = haystack.end();
+
+      std::vector<I> lbs, ubs;
+      std::vector<std::pair<I, I>> eqs;
+      srt::lower_bound_biased_batch(f, l, nf, nl, std::back_inserter(lbs));
+      srt::upper_bound_biased_batch(f, l, nf, nl, std::back_inserter(ubs));
+      srt::equal_range_biased_batch(f, l, nf, nl, std::back_inserter(eqs));
+
+      REQUIRE(lbs.size() == static_cast<std::size_t>(nl - nf));
+      REQUIRE(ubs.size() == lbs.size());
+      REQUIRE(eqs.size() == lbs.size());
+
+      for (std::size_t i = 0; i != lbs.size(); ++i) {
+        int needle = nf[static_cast<std::ptrdiff_t>(i)];
+        REQUIRE(lbs[i] == std::lower_bound(f, l, needle));
+        REQUIRE(ubs[i] == std::upper_bound(f, l, needle));
+        REQUIRE(eqs[i] == std::equal_range(f, l, needle));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("biased_batch", "[batch]") {
+  std::vector<int> v_data;
+  for (int i = 0; i < 10; ++i)
+    for (int j = 0; j < i; ++j) v_data.push_back(i);
+
+  test_biased_batch(v_data);
+  test_biased_batch(std::list<int>(v_data.begin(), v_data.end()));
+}
+
+// ----------------------------------------------
+
+namespace {
+
+// Elements are compared by key, the tag shows which copy was output.
+using tagged = std::pair<int, int>;
+
+std::vector<tagged> random_tagged_multiset(std::mt19937& g, int size,
+                                           int max_key, int tag) {
+  std::uniform_int_distribution<int> dis(0, max_key);
+  std::vector<tagged> res;
+  for (int i = 0; i < size; ++i) res.emplace_back(dis(g), tag);
+  std::sort(res.begin(), res.end());
+  for (auto& x : res) x.second = tag++;
+  return res;
+}
+
+template <typename C>
+void test_set_algorithms_biased(const C& a, const C& b) {
+  auto p = [](const tagged& x, const tagged& y) { return x.first < y.first; };
+
+  std::vector<tagged> expected, actual;
+
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected), p);
+  srt::set_intersection_biased(a.begin(), a.end(), b.begin(), b.end(),
+                               std::back_inserter(actual), p);
+  REQUIRE(expected == actual);
+
+  expected.clear();
+  actual.clear();
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                      std::back_inserter(expected), p);
+  srt::set_difference_biased(a.begin(), a.end(), b.begin(), b.end(),
+                             std::back_inserter(actual), p);
+  REQUIRE(expected == actual);
+
+  expected.clear();
+  actual.clear();
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                 std::back_inserter(expected), p);
+  srt::set_union_biased(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(actual), p);
+  REQUIRE(expected == actual);
+
+  REQUIRE(std::includes(a.begin(), a.end(), b.begin(), b.end(), p) ==
+          srt::includes_biased(a.begin(), a.end(), b.begin(), b.end(), p));
+}
+
+}  // namespace
+
+TEST_CASE("set_algorithms_biased", "[set_algorithms]") {
+  std::mt19937 g;
+
+  for (int a_size = 0; a_size < 40; a_size += 3) {
+    for (int b_size = 0; b_size < 40; b_size += 3) {
+      for (int max_key : {3, 20, 100}) {
+        auto a = random_tagged_multiset(g, a_size, max_key, 0);
+        auto b = random_tagged_multiset(g, b_size, max_key, 1000);
+        test_set_algorithms_biased(a, b);
+        test_set_algorithms_biased(b, a);
+        test_set_algorithms_biased(a, a);
+
+        std::list<tagged> a_list(a.begin(), a.end());
+        std::list<tagged> b_list(b.begin(), b.end());
+        test_set_algorithms_biased(a_list, b_list);
+      }
+    }
+  }
+
+  std::vector<tagged> a = random_tagged_multiset(g, 200, 50, 0);
+  std::vector<tagged> subset;
+  for (std::size_t i = 0; i < a.size(); i += 7) subset.push_back(a[i]);
+  REQUIRE(srt::includes_biased(a.begin(), a.end(), subset.begin(), subset.end(),
+                               [](const tagged& x, const tagged& y) {
+                                 return x.first < y.first;
+                               }));
+}
+
+// ----------------------------------------------
+
+namespace {
+
+// Different kinds of interleaving: random, long blocks, disjoint.
+std::vector<tagged> tagged_runs_for_merge(std::mt19937& g, int size,
+                                          int block, int offset, int tag) {
+  std::uniform_int_distribution<int> dis(0, 1);
+  std::vector<tagged> res;
+  int key = offset;
+  for (int i = 0; i < size; ++i) {
+    if (i % block == 0) key += block * dis(g);
+    key += dis(g);
+    res.emplace_back(key, tag++);
+  }
+  return res;
+}
+
+template <typename C>
+void test_merge_biased(const C& a, const C& b) {
+  auto p = [](const tagged& x, const tagged& y) { return x.first < y.first; };
+
+  std::vector<tagged> expected, actual;
+  std::merge(a.begin(), a.end(), b.begin(), b.end(),
+             std::back_inserter(expected), p);
+  srt::merge_biased(a.begin(), a.end(), b.begin(), b.end(),
+                    std::back_inserter(actual), p);
+  REQUIRE(expected == actual);
+
+  C both(a.begin(), a.end());
+  both.insert(both.end(), b.begin(), b.end());
+  srt::inplace_merge_biased(both.begin(), std::next(both.begin(), a.size()),
+                            both.end(), p);
+  REQUIRE(std::vector<tagged>(both.begin(), both.end()) == expected);
+}
+
+}  // namespace
+
+TEST_CASE("merge_biased", "[merge]") {
+  std::mt19937 g;
+
+  for (int a_size : {0, 1, 5, 30, 200}) {
+    for (int b_size : {0, 1, 7, 40, 300}) {
+      for (int block : {1, 10, 50}) {
+        for (int offset : {0, 100, 1000}) {
+          auto a = tagged_runs_for_merge(g, a_size, block, 0, 0);
+          auto b = tagged_runs_for_merge(g, b_size, block, offset, 1000);
+          test_merge_biased(a, b);
+          test_merge_biased(b, a);
+          test_merge_biased(std::list<tagged>(a.begin(), a.end()),
+                            std::list<tagged>(b.begin(), b.end()));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("inplace_merge_biased_int", "[merge]") {
+  std::mt19937 g;
+  std::uniform_int_distribution<int> dis(0, 50);
+
+  for (int size = 0; size < 100; ++size) {
+    std::vector<int> v(static_cast<std::size_t>(size));
+    for (int& x : v) x = dis(g);
+
+    for (int m = 0; m <= size; m += 3) {
+      std::vector<int> expected = v;
+      std::sort(expected.begin(), expected.begin() + m);
+      std::sort(expected.begin() + m, expected.end());
+      std::vector<int> actual = expected;
+
+      std::vector<int> merged;
+      srt::merge_biased(expected.begin(), expected.begin() + m,
+                        expected.begin() + m, expected.end(),
+                        std::back_inserter(merged));
+      std::inplace_merge(expected.begin(), expected.begin() + m,
+                         expected.end());
+      srt::inplace_merge_biased(actual.begin(), actual.begin() + m,
+                                actual.end());
+
+      REQUIRE(expected == actual);
+      REQUIRE(expected == merged);
+    }
+  }
+}
+
+// ----------------------------------------------
+
+TEST_CASE("sort_adaptive", "[sort]") {
+  std::mt19937 g;
+  auto p = [](const tagged& x, const tagged& y) { return x.first < y.first; };
+
+  for (int size : {0, 1, 2, 31, 32, 33, 100, 1000}) {
+    for (int runs : {1, 2, 3, 7, 50}) {
+      for (int max_key : {5, 1000}) {
+        std::vector<tagged> v;
+        for (int r = 0; r < runs; ++r) {
+          auto run = random_tagged_multiset(g, size / runs, max_key, 0);
+          if (r % 3 == 2) std::reverse(run.begin(), run.end());
+          v.insert(v.end(), run.begin(), run.end());
+        }
+        for (std::size_t i = 0; i != v.size(); ++i)
+          v[i].second = static_cast<int>(i);
+
+        auto expected = v;
+        std::stable_sort(expected.begin(), expected.end(), p);
+        srt::sort_adaptive(v.begin(), v.end(), p);
+        REQUIRE(expected == v);
+      }
+    }
+  }
+
+  std::uniform_int_distribution<int> dis(0, 100);
+  std::vector<int> random_ints(5000);
+  for (int& x : random_ints) x = dis(g);
+  auto expected = random_ints;
+  std::sort(expected.begin(), expected.end());
+  srt::sort_adaptive(random_ints.begin(), random_ints.end());
+  REQUIRE(expected == random_ints);
+}
+
+// ----------------------------------------------
+
+TEST_CASE("unique_biased", "[unique]") {
+  std::mt19937 g;
+  auto p = [](const tagged& x, const tagged& y) { return x.first < y.first; };
+  auto eq = [](const tagged& x, const tagged& y) { return x.first == y.first; };
+
+  for (int size : {0, 1, 2, 10, 100, 1000}) {
+    for (int max_key : {0, 3, 50, 10000}) {
+      auto v = random_tagged_multiset(g, size, max_key, 0);
+
+      std::vector<tagged> expected(v.begin(), std::unique(v.begin(), v.end(), eq));
+
+      std::vector<tagged> copied;
+      srt::unique_copy_biased(v.begin(), v.end(), std::back_inserter(copied), p);
+      REQUIRE(expected == copied);
+
+      std::list<tagged> as_list(v.begin(), v.end());
+      copied.assign(as_list.begin(),
+                    srt::unique_biased(as_list.begin(), as_list.end(), p));
+      REQUIRE(expected == copied);
+
+      v.erase(srt::unique_biased(v.begin(), v.end(), p), v.end());
+      REQUIRE(expected == v);
+    }
+  }
+}
+
+// ----------------------------------------------
+
+namespace {
+
+template <typename T>
+void test_biased_simd_dispatch() {
+  static_assert(srt::use_simd_biased_search<typename std::vector<T>::iterator,
+                                            T, srt::less>::value ==
+                    (srt::simd_traits<T>::width != 0),
+                "");
+
+  for (int size = 0; size < 150; ++size) {
+    std::vector<T> v;
+    for (int i = 0; i < size; ++i) v.push_back(static_cast<T>(i / 3));
+
+    for (int i = -1; i <= size / 3 + 1; ++i) {
+      T x = static_cast<T>(i);
+      for (auto f = v.begin(); f != v.end(); f += std::min<std::ptrdiff_t>(7, v.end() - f)) {
+        REQUIRE(srt::lower_bound_biased(f, v.end(), x) ==
+                std::lower_bound(f, v.end(), x));
+        REQUIRE(srt::upper_bound_biased(f, v.end(), x) ==
+                std::upper_bound(f, v.end(), x));
+      }
+
+      const T* ptr = v.data();
+      REQUIRE(srt::lower_bound_biased(ptr, ptr + size, x) ==
+              std::lower_bound(ptr, ptr + size, x));
+      REQUIRE(srt::upper_bound_biased(ptr, ptr + size, x) ==
+              std::upper_bound(ptr, ptr + size, x));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("biased_simd", "[simd]") {
+  test_biased_simd_dispatch<std::int32_t>();
+  test_biased_simd_dispatch<std::int64_t>();
+  test_biased_simd_dispatch<float>();
+  test_biased_simd_dispatch<double>();
+}
+
+// ----------------------------------------------
+
+TEST_CASE("lower_bound_biased_branchless", "[branchless]") {
+  test_lower_bound([](auto f, auto, auto l, const auto& v) {
+    return srt::lower_bound_biased_branchless(f, l, v);
+  });
+}
+
+TEST_CASE("upper_bound_biased_branchless", "[branchless]") {
+  test_upper_bound([](auto f, auto, auto l, const auto& v) {
+    return srt::upper_bound_biased_branchless(f, l, v);
+  });
+}
+
+TEST_CASE("equal_range_biased_branchless", "[branchless]") {
+  test_equal_range([](auto f, auto, auto l, const auto& v) {
+    return srt::equal_range_biased_branchless(f, l, v);
+  });
+}
+
+// ----------------------------------------------
+
 TEST_CASE("lower_bound_hinted", "[blog_post]") {
   test_lower_bound([](auto f, auto h, auto l, const auto& v) {
     return srt::lower_bound_hinted(f, h, l, v);
@@ -172,6 +516,138 @@ TEST_CASE("equal_range_hinted", "[blog_post]") {
 
 // ----------------------------------------------
 
+TEST_CASE("lower_bound_biased_n", "[single_pass]") {
+  test_lower_bound([](auto f, auto, auto l, const auto& v) {
+    return srt::lower_bound_biased_n(f, std::distance(f, l), v);
+  });
+}
+
+TEST_CASE("upper_bound_biased_n", "[single_pass]") {
+  test_upper_bound([](auto f, auto, auto l, const auto& v) {
+    return srt::upper_bound_biased_n(f, std::distance(f, l), v);
+  });
+}
+
+namespace {
+
+// Forward iterator that counts how many times it was incremented.
+struct counting_iterator {
+  using difference_type = std::ptrdiff_t;
+  using value_type = int;
+  using pointer = const int*;
+  using reference = const int&;
+  using iterator_category = std::forward_iterator_tag;
+
+  std::forward_list<int>::const_iterator it;
+  std::ptrdiff_t* increments;
+
+  reference operator*() const { return *it; }
+  counting_iterator& operator++() {
+    ++it;
+    ++*increments;
+    return *this;
+  }
+  counting_iterator operator++(int) {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  friend bool operator==(const counting_iterator& x, const counting_iterator& y) {
+    return x.it == y.it;
+  }
+  friend bool operator!=(const counting_iterator& x, const counting_iterator& y) {
+    return !(x == y);
+  }
+};
+
+}  // namespace
+
+TEST_CASE("forward_biased_single_pass", "[single_pass]") {
+  for (int size = 0; size < 300; size += 1 + size / 10) {
+    std::vector<int> v(static_cast<std::size_t>(size));
+    std::iota(v.begin(), v.end(), 0);
+    std::forward_list<int> fl(v.begin(), v.end());
+
+    for (int x = -1; x <= size; ++x) {
+      std::ptrdiff_t increments = 0;
+      counting_iterator f{fl.begin(), &increments};
+      counting_iterator l{fl.end(), &increments};
+
+      auto expected = std::min(std::max(x, 0), size);
+
+      auto res = srt::lower_bound_biased(f, l, x);
+      REQUIRE(std::distance(fl.cbegin(), res.it) == expected);
+      REQUIRE(increments <= size);
+
+      increments = 0;
+      res = srt::lower_bound_biased_n(f, size, x);
+      REQUIRE(std::distance(fl.cbegin(), res.it) == expected);
+      REQUIRE(increments <= size);
+
+      increments = 0;
+      res = srt::upper_bound_biased_n(f, size, x);
+      REQUIRE(std::distance(fl.cbegin(), res.it) ==
+              std::min(std::max(x + 1, 0), size));
+      REQUIRE(increments <= size);
+    }
+  }
+}
+
+// ----------------------------------------------
+
+namespace {
+
+template <typename T, typename Gen>
+void test_interpolated_biased(Gen gen) {
+  std::mt19937 g;
+
+  for (int size = 0; size < 200; size += 1 + size / 10) {
+    std::vector<T> v(static_cast<std::size_t>(size));
+    for (T& x : v) x = gen(g);
+    std::sort(v.begin(), v.end());
+
+    std::vector<T> needles = v;
+    for (int i = 0; i < 20; ++i) needles.push_back(gen(g));
+
+    for (T x : needles) {
+      REQUIRE(srt::lower_bound_interpolated_biased(v.begin(), v.end(), x) ==
+              std::lower_bound(v.begin(), v.end(), x));
+      REQUIRE(srt::upper_bound_interpolated_biased(v.begin(), v.end(), x) ==
+              std::upper_bound(v.begin(), v.end(), x));
+      REQUIRE(srt::equal_range_interpolated_biased(v.begin(), v.end(), x) ==
+              std::equal_range(v.begin(), v.end(), x));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("interpolated_biased", "[interpolated]") {
+  test_interpolated_biased<int>(
+      [](std::mt19937& g) { return std::uniform_int_distribution<int>(-100, 100)(g); });
+  test_interpolated_biased<int>(
+      [](std::mt19937& g) { return std::uniform_int_distribution<int>(0, 3)(g); });
+  // Skewed: most keys are small, a few are huge.
+  test_interpolated_biased<std::int64_t>([](std::mt19937& g) {
+    auto x = std::uniform_int_distribution<std::int64_t>(0, 100)(g);
+    return x < 95 ? x : x * 1000000000000ll;
+  });
+  test_interpolated_biased<std::uint64_t>([](std::mt19937& g) {
+    return std::uniform_int_distribution<std::uint64_t>(
+        0, std::numeric_limits<std::uint64_t>::max())(g);
+  });
+  test_interpolated_biased<double>(
+      [](std::mt19937& g) { return std::lognormal_distribution<double>(0, 3)(g); });
+  test_interpolated_biased<double>([](std::mt19937& g) {
+    double x = std::uniform_real_distribution<double>(-1, 1)(g);
+    if (x > 0.9) return std::numeric_limits<double>::infinity();
+    if (x < -0.9) return -std::numeric_limits<double>::max();
+    return x;
+  });
+}
+
+// ----------------------------------------------
+
 TEST_CASE("lower_bound_with_unsigned", "[SeanParentTwit]") {
   test_lower_bound([](auto f, auto, auto l, const auto& v) {
     return srt::lower_bound_with_unsigned(f, l, v);
@@ -231,4 +707,124 @@ TEST_CASE("group_equals", "[blog_post]") {
       REQUIRE(actual == expected);
     }
   }
-}
\ No newline at end of file
+}
+
+// ----------------------------------------------
+
+namespace {
+
+auto int_three_way() {
+  return srt::three_way([](int x, int y) { return x < y ? -1 : x > y; });
+}
+
+}  // namespace
+
+TEST_CASE("equal_range_n_three_way", "[three_way]") {
+  test_equal_range([](auto f, auto, auto l, const auto& v) {
+    return srt::equal_range_n(f, std::distance(f, l), v, int_three_way());
+  });
+}
+
+TEST_CASE("equal_range_biased_three_way", "[three_way]") {
+  test_equal_range([](auto f, auto, auto l, const auto& v) {
+    return srt::equal_range_biased(f, l, v, int_three_way());
+  });
+}
+
+TEST_CASE("equal_range_hinted_three_way", "[three_way]") {
+  test_equal_range([](auto f, auto h, auto l, const auto& v) {
+    return srt::equal_range_hinted(f, h, l, v, int_three_way());
+  });
+}
+
+TEST_CASE("three_way_for_strings", "[three_way]") {
+  static_assert(
+      std::is_same<srt::default_compare<std::string, const char*>,
+                   srt::three_way_compare<srt::compare_member>>::value,
+      "");
+  static_assert(
+      std::is_same<srt::default_compare<int, int>, srt::less>::value, "");
+
+  std::vector<std::string> v;
+  for (int i = 0; i < 100; ++i)
+    for (int j = 0; j < i % 3; ++j) v.push_back(std::to_string(1000 + i));
+  std::forward_list<std::string> fl(v.begin(), v.end());
+
+  for (int i = 999; i <= 1100; ++i) {
+    std::string needle = std::to_string(i);
+    auto expected = std::equal_range(v.begin(), v.end(), needle);
+    auto n = static_cast<std::ptrdiff_t>(v.size());
+
+    // Heterogeneous: std::string::compare(const char*).
+    REQUIRE(srt::equal_range_n(v.begin(), n, needle.c_str()) == expected);
+    REQUIRE(srt::equal_range_biased(v.begin(), v.end(), needle.c_str()) ==
+            expected);
+    for (std::size_t h = 0; h <= v.size(); h += 7)
+      REQUIRE(srt::equal_range_hinted(v.begin(), v.begin() + h, v.end(),
+                                      needle.c_str()) == expected);
+
+    auto fl_res = srt::equal_range_biased(fl.begin(), fl.end(), needle);
+    REQUIRE(std::distance(fl.begin(), fl_res.first) ==
+            expected.first - v.begin());
+    REQUIRE(std::distance(fl.begin(), fl_res.second) ==
+            expected.second - v.begin());
+  }
+}
+
+TEST_CASE("three_way_one_argument_order", "[three_way]") {
+  // Takes only (element, value): the wrapper flips the reversed calls.
+  auto c = srt::three_way([](const std::string& x, const char* y) {
+    return x.compare(y);
+  });
+
+  std::vector<std::string> v{"a", "b", "b", "c", "e"};
+  std::forward_list<std::string> fl(v.begin(), v.end());
+
+  for (const char* needle : {"", "a", "b", "c", "d", "e", "f"}) {
+    auto lb = std::lower_bound(v.begin(), v.end(), std::string(needle));
+    auto ub = std::upper_bound(v.begin(), v.end(), std::string(needle));
+    auto n = static_cast<std::ptrdiff_t>(v.size());
+
+    REQUIRE(srt::lower_bound_biased(v.begin(), v.end(), needle, c) == lb);
+    REQUIRE(srt::upper_bound_biased(v.begin(), v.end(), needle, c) == ub);
+    REQUIRE(srt::upper_bound_n(v.begin(), n, needle, c) == ub);
+    REQUIRE(srt::equal_range_n(v.begin(), n, needle, c) ==
+            std::make_pair(lb, ub));
+    REQUIRE(std::distance(fl.begin(), srt::upper_bound_biased(
+                                          fl.begin(), fl.end(), needle, c)) ==
+            ub - v.begin());
+
+    // The default for std::string and const char* is three-way too.
+    REQUIRE(srt::upper_bound_biased(v.begin(), v.end(), needle) == ub);
+  }
+}
+
+TEST_CASE("three_way_fewer_calls", "[three_way]") {
+  std::vector<int> v(1000);
+  std::iota(v.begin(), v.end(), 0);
+  auto n = static_cast<std::ptrdiff_t>(v.size());
+
+  int two_way_calls = 0;
+  int three_way_calls = 0;
+  auto two_way = [&](int x, int y) {
+    ++two_way_calls;
+    return x < y;
+  };
+  auto three_way = srt::three_way([&](int x, int y) {
+    ++three_way_calls;
+    return x < y ? -1 : x > y;
+  });
+
+  for (int x : v) {
+    srt::equal_range_n(v.begin(), n, x, two_way);
+    srt::equal_range_n(v.begin(), n, x, three_way);
+  }
+  REQUIRE(three_way_calls < two_way_calls);
+
+  two_way_calls = three_way_calls = 0;
+  for (int x : v) {
+    srt::equal_range_biased(v.begin(), v.end(), x, two_way);
+    srt::equal_range_biased(v.begin(), v.end(), x, three_way);
+  }
+  REQUIRE(three_way_calls < two_way_calls);
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "result.h"
+
+// Parallel versions of the algorithms from result.h. Everything here
+// takes the number of threads to use explicitly, including the calling
+// thread, so 1 means "run sequentially".
+
+namespace srt {
+
+inline std::size_t default_thread_count() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls fn(i) for every i in [0, n), each on its own thread.
+// The calling thread takes i == 0.
+template <typename F>
+// requires Invocable<F, std::size_t>
+void run_in_parallel(std::size_t n, F fn) {
+  if (n == 0) return;
+
+  std::vector<std::thread> workers;
+  workers.reserve(n - 1);
+  for (std::size_t i = 1; i != n; ++i) workers.emplace_back(fn, i);
+  fn(0);
+  for (auto& w : workers) w.join();
+}
+
+// Splits [f, l) into at most `parts` chunks of roughly equal size, so
+// that no group of equivalent elements is split. Returns chunk
+// boundaries: {f, ..., l}, all chunks are non empty unless f == l.
+template <typename I, typename P>
+// requires RandomAccessIterator<I> && StrictWeakOrder<P(ValueType<I>)>
+std::vector<I> split_at_group_boundaries(I f, I l, P p, std::size_t parts) {
+  std::vector<I> res{f};
+  DifferenceType<I> n = l - f;
+  parts = std::max<std::size_t>(parts, 1);
+
+  for (std::size_t i = 1; i < parts; ++i) {
+    I candidate = f + static_cast<DifferenceType<I>>(
+                          static_cast<std::size_t>(n) * i / parts);
+    I from = std::max(candidate, res.back());
+    if (from == l) break;
+    // Groups are expected to be short compared to the chunks.
+    I boundary = upper_bound_biased(from, l, *from, p);
+    if (boundary == l) break;
+    res.push_back(boundary);
+  }
+
+  if (res.back() != l || res.size() == 1) res.push_back(l);
+  return res;
+}
+
+template <typename I>
+// requires RandomAccessIterator<I> && TotallyOrdered<ValueType<I>>
+std::vector<I> split_at_group_boundaries(I f, I l, std::size_t parts) {
+  return split_at_group_boundaries(f, l, less{}, parts);
+}
+
+// Sorts chunks with sort_adaptive, one per thread, and then merges
+// neighbours pairwise, halving the number of threads at each level.
+// Stable.
+template <typename I, typename P>
+// requires RandomAccessIterator<I> && StrictWeakOrder<P(ValueType<I>)>
+void parallel_sort_adaptive(I f, I l, P p, std::size_t threads) {
+  DifferenceType<I> n = l - f;
+  threads = std::max<std::size_t>(threads, 1);
+  // Not worth a thread below a run.
+  threads = std::min(threads, static_cast<std::size_t>(n / kMinRun) + 1);
+
+  std::vector<I> bounds;
+  for (std::size_t i = 0; i != threads; ++i)
+    bounds.push_back(f + static_cast<DifferenceType<I>>(
+                             static_cast<std::size_t>(n) * i / threads));
+  bounds.push_back(l);
+
+  run_in_parallel(threads, [&](std::size_t i) {
+    sort_adaptive(bounds[i], bounds[i + 1], p);
+  });
+
+  while (bounds.size() > 2) {
+    std::size_t merges = (bounds.size() - 1) / 2;
+    run_in_parallel(merges, [&](std::size_t i) {
+      inplace_merge_biased(bounds[2 * i], bounds[2 * i + 1], bounds[2 * i + 2],
+                           p);
+    });
+
+    std::vector<I> next;
+    for (std::size_t i = 0; i < bounds.size(); i += 2) next.push_back(bounds[i]);
+    if (next.back() != l) next.push_back(l);
+    bounds = std::move(next);
+  }
+}
+
+template <typename I>
+// requires RandomAccessIterator<I> && TotallyOrdered<ValueType<I>>
+void parallel_sort_adaptive(I f, I l, std::size_t threads) {
+  parallel_sort_adaptive(f, l, less{}, threads);
+}
+
+// Work split of parallel_for_each_group for one thread.
+struct group_load_stats {
+  std::size_t chunks = 0;
+  std::size_t stolen_chunks = 0;
+  std::size_t groups = 0;
+  std::ptrdiff_t elements = 0;
+};
+
+// How many chunks per thread parallel_for_each_group aims for: more
+// chunks balance better, fewer have less overhead.
+constexpr std::size_t kChunksPerThread = 16;
+
+namespace detail {
+
+class chunk_queue {
+  std::mutex mutex_;
+  std::deque<std::size_t> chunks_;
+
+ public:
+  void push(std::size_t chunk) { chunks_.push_back(chunk); }
+
+  bool pop_front(std::size_t& chunk) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (chunks_.empty()) return false;
+    chunk = chunks_.front();
+    chunks_.pop_front();
+    return true;
+  }
+
+  bool steal_back(std::size_t& chunk) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (chunks_.empty()) return false;
+    chunk = chunks_.back();
+    chunks_.pop_back();
+    return true;
+  }
+};
+
+}  // namespace detail
+
+// Calls fn(range_pair<I>) for every group of equivalent elements in
+// [f, l), on up to `threads` threads. fn is called concurrently for
+// different groups, in no particular order.
+//
+// The range is cut at group boundaries into a number of chunks; each
+// thread starts with a contiguous block of them and, when it runs out,
+// steals from the back of the others. A group is never split, so one
+// huge group still goes to one thread, but it does not hold up the
+// chunks queued behind it.
+//
+// Returns load statistics for each thread that was used.
+template <typename I, typename P, typename Fn>
+// requires RandomAccessIterator<I> && StrictWeakOrder<P(ValueType<I>)> &&
+//          Invocable<Fn, range_pair<I>>
+std::vector<group_load_stats> parallel_for_each_group(I f, I l, P p, Fn fn,
+                                                      std::size_t threads) {
+  threads = std::max<std::size_t>(threads, 1);
+  auto bounds = split_at_group_boundaries(f, l, p, threads * kChunksPerThread);
+  std::size_t chunks = bounds.size() - 1;
+  threads = std::min(threads, chunks);
+
+  std::vector<detail::chunk_queue> queues(threads);
+  for (std::size_t i = 0; i != chunks; ++i)
+    queues[i * threads / chunks].push(i);
+
+  std::vector<group_load_stats> res(threads);
+  run_in_parallel(threads, [&](std::size_t self) {
+    group_load_stats stats;
+
+    auto next_chunk = [&](std::size_t& chunk) {
+      if (queues[self].pop_front(chunk)) return true;
+      for (std::size_t i = 1; i != threads; ++i) {
+        if (queues[(self + i) % threads].steal_back(chunk)) {
+          ++stats.stolen_chunks;
+          return true;
+        }
+      }
+      return false;
+    };
+
+    std::size_t chunk;
+    while (next_chunk(chunk)) {
+      ++stats.chunks;
+      stats.elements += bounds[chunk + 1] - bounds[chunk];
+      for (const auto& r : group_equals(bounds[chunk], bounds[chunk + 1], p)) {
+        fn(r);
+        ++stats.groups;
+      }
+    }
+
+    res[self] = stats;
+  });
+
+  return res;
+}
+
+template <typename I, typename Fn>
+// requires RandomAccessIterator<I> && TotallyOrdered<ValueType<I>> &&
+//          Invocable<Fn, range_pair<I>>
+std::vector<group_load_stats> parallel_for_each_group(I f, I l, Fn fn,
+                                                      std::size_t threads) {
+  return parallel_for_each_group(f, l, less{}, fn, threads);
+}
+
+}  // namespace srt
@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "parallel_algorithms.h"
+
+namespace {
+
+constexpr std::size_t kElementsCount = 10000000u;
+
+enum group_sizes : int {
+  kUniform = 0,   // Every group has ~100 elements.
+  kPareto = 1,    // Pareto distributed sizes, shuffled.
+  kHeadHeavy = 2  // Same sizes, but the biggest groups come first.
+};
+
+std::vector<std::int64_t> sorted_groups(int distribution) {
+  std::mt19937 g;
+  std::vector<std::size_t> sizes;
+  std::size_t total = 0;
+
+  std::uniform_real_distribution<double> u(0.0, 1.0);
+  while (total < kElementsCount) {
+    std::size_t size = 100;
+    if (distribution != kUniform) {
+      // alpha = 1.1, capped at a tenth of the input.
+      double pareto = 10.0 * std::pow(1.0 - u(g), -1.0 / 1.1);
+      size = static_cast<std::size_t>(
+          std::min(pareto, static_cast<double>(kElementsCount / 10)));
+    }
+    size = std::min(size, kElementsCount - total);
+    sizes.push_back(size);
+    total += size;
+  }
+
+  if (distribution == kHeadHeavy)
+    std::sort(sizes.begin(), sizes.end(), std::greater<>{});
+
+  std::vector<std::int64_t> res;
+  res.reserve(kElementsCount);
+  std::int64_t key = 0;
+  for (std::size_t size : sizes) {
+    res.insert(res.end(), size, key);
+    ++key;
+  }
+  return res;
+}
+
+void set_threads_and_distribution(benchmark::internal::Benchmark* bench) {
+  std::size_t cores = srt::default_thread_count();
+  for (int distribution : {kUniform, kPareto, kHeadHeavy}) {
+    for (std::size_t n = 1; n < cores; n *= 2)
+      bench->Args({static_cast<int>(n), distribution});
+    bench->Args({static_cast<int>(cores), distribution});
+  }
+}
+
+// Some cpu work proportional to the group size.
+template <typename R>
+void process_group(const R& r) {
+  std::uint64_t acc = 0;
+  for (auto x : r)
+    acc = (acc ^ static_cast<std::uint64_t>(x)) * 0x9E3779B97F4A7C15u;
+  benchmark::DoNotOptimize(acc);
+}
+
+// One chunk per thread, no stealing.
+struct static_split {
+  template <typename I, typename Fn>
+  std::vector<srt::group_load_stats> operator()(I f, I l, Fn fn,
+                                                std::size_t threads) {
+    auto bounds = srt::split_at_group_boundaries(f, l, threads);
+    std::vector<srt::group_load_stats> res(bounds.size() - 1);
+    srt::run_in_parallel(res.size(), [&](std::size_t i) {
+      res[i].chunks = 1;
+      res[i].elements = bounds[i + 1] - bounds[i];
+      for (const auto& r :
+           srt::group_equals(bounds[i], bounds[i + 1], srt::less{})) {
+        fn(r);
+        ++res[i].groups;
+      }
+    });
+    return res;
+  }
+};
+
+struct work_stealing {
+  template <typename I, typename Fn>
+  std::vector<srt::group_load_stats> operator()(I f, I l, Fn fn,
+                                                std::size_t threads) {
+    return srt::parallel_for_each_group(f, l, fn, threads);
+  }
+};
+
+}  // namespace
+
+template <typename Runner>
+void benchmark_for_each_group(benchmark::State& state) {
+  const auto input = sorted_groups(static_cast<int>(state.range(1)));
+  auto threads = static_cast<std::size_t>(state.range(0));
+
+  std::vector<srt::group_load_stats> stats;
+  for (auto _ : state) {
+    stats = Runner{}(input.begin(), input.end(),
+                     [](const auto& r) { process_group(r); }, threads);
+  }
+
+  // The most loaded thread relative to a perfect split: 1 is ideal.
+  std::ptrdiff_t max_elements = 0;
+  std::size_t stolen = 0;
+  for (const auto& s : stats) {
+    max_elements = std::max(max_elements, s.elements);
+    stolen += s.stolen_chunks;
+  }
+  state.counters["imbalance"] = static_cast<double>(max_elements) *
+                                static_cast<double>(threads) /
+                                static_cast<double>(input.size());
+  state.counters["stolen"] = static_cast<double>(stolen);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(input.size()));
+}
+
+BENCHMARK_TEMPLATE(benchmark_for_each_group, static_split)
+    ->Apply(set_threads_and_distribution)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(benchmark_for_each_group, work_stealing)
+    ->Apply(set_threads_and_distribution)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,100 @@
+#include "parallel_algorithms.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+TEST_CASE("split_at_group_boundaries", "[parallel]") {
+  std::mt19937 g;
+
+  for (int size = 0; size < 100; ++size) {
+    for (int max_key : {0, 2, 10, 1000}) {
+      std::uniform_int_distribution<int> dis(0, max_key);
+      std::vector<int> v(static_cast<std::size_t>(size));
+      for (int& x : v) x = dis(g);
+      std::sort(v.begin(), v.end());
+
+      for (std::size_t parts : {1u, 2u, 3u, 7u, 200u}) {
+        auto bounds = srt::split_at_group_boundaries(v.begin(), v.end(), parts);
+
+        REQUIRE(bounds.size() >= 2);
+        REQUIRE(bounds.size() <= parts + 1);
+        REQUIRE(bounds.front() == v.begin());
+        REQUIRE(bounds.back() == v.end());
+        for (std::size_t i = 1; i + 1 < bounds.size(); ++i) {
+          REQUIRE(bounds[i - 1] < bounds[i]);
+          REQUIRE(*(bounds[i] - 1) < *bounds[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("parallel_sort_adaptive", "[parallel]") {
+  std::mt19937 g;
+
+  for (int size : {0, 1, 31, 32, 100, 1000, 10000}) {
+    std::uniform_int_distribution<int> dis(0, size / 4);
+    std::vector<std::pair<int, int>> v;
+    for (int i = 0; i < size; ++i) v.emplace_back(dis(g), i);
+
+    auto expected = v;
+    auto by_first = [](const auto& x, const auto& y) { return x.first < y.first; };
+    std::stable_sort(expected.begin(), expected.end(), by_first);
+
+    for (std::size_t threads : {1u, 2u, 3u, 4u, 5u, 8u}) {
+      auto actual = v;
+      srt::parallel_sort_adaptive(actual.begin(), actual.end(), by_first,
+                                  threads);
+      REQUIRE(actual == expected);
+    }
+  }
+}
+
+TEST_CASE("parallel_for_each_group", "[parallel]") {
+  std::mt19937 g;
+
+  for (int size : {0, 1, 10, 100, 1000, 10000}) {
+    for (int max_key : {0, 3, 100, 100000}) {
+      std::uniform_int_distribution<int> dis(0, max_key);
+      std::vector<int> v(static_cast<std::size_t>(size));
+      for (int& x : v) x = dis(g);
+      std::sort(v.begin(), v.end());
+
+      // Every group writes only the slot of its first element.
+      std::vector<int> expected(v.size(), 0);
+      for (auto r : srt::group_equals(v.begin(), v.end(), srt::less{}))
+        expected[static_cast<std::size_t>(r.begin() - v.begin())] =
+            static_cast<int>(r.end() - r.begin());
+
+      for (std::size_t threads : {1u, 2u, 3u, 8u}) {
+        std::vector<int> actual(v.size(), 0);
+        auto stats = srt::parallel_for_each_group(
+            v.begin(), v.end(),
+            [&](const auto& r) {
+              actual[static_cast<std::size_t>(r.begin() - v.begin())] =
+                  static_cast<int>(r.end() - r.begin());
+            },
+            threads);
+
+        REQUIRE(actual == expected);
+        REQUIRE(!stats.empty());
+        REQUIRE(stats.size() <= threads);
+
+        srt::group_load_stats total;
+        for (const auto& s : stats) {
+          total.chunks += s.chunks;
+          total.groups += s.groups;
+          total.elements += s.elements;
+        }
+        REQUIRE(total.elements == size);
+        REQUIRE(total.groups ==
+                static_cast<std::size_t>(std::count_if(
+                    expected.begin(), expected.end(),
+                    [](int x) { return x != 0; })));
+      }
+    }
+  }
+}
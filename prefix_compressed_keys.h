@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+
+namespace srt {
+
+// Sorted strings, front coded: keys are stored in blocks of block_size,
+// each block starts with a whole key (the head) and every next key is
+// (length of the prefix shared with the previous key, the rest). All
+// blocks are in one arena, heads_ has where each block starts.
+//
+// Searches never compare a character twice: the search over the heads
+// skips the prefix the query is known to share with both ends of the
+// remaining range, and the scan of a block keeps the length m of the
+// prefix shared by the query and the current key. A key that shares
+// more than m with the previous one is still before the query, a key
+// that shares less is after it, only when it shares exactly m do we
+// compare, from m on.
+//
+// Searches return ranks: positions in the sorted order.
+
+class prefix_compressed_keys {
+  struct key_ref {
+    const char* data;
+    std::size_t size;
+  };
+
+  std::vector<char> arena_;
+  std::vector<std::size_t> heads_;  // offsets in arena_
+  std::size_t block_size_ = kDefaultBlockSize;
+  std::size_t size_ = 0;
+
+  void write_varint(std::size_t x) {
+    while (x >= 0x80) {
+      arena_.push_back(static_cast<char>(x | 0x80));
+      x >>= 7;
+    }
+    arena_.push_back(static_cast<char>(x));
+  }
+
+  static std::size_t read_varint(const char*& p) {
+    std::size_t res = 0;
+    for (int shift = 0;; shift += 7) {
+      auto byte = static_cast<unsigned char>(*p++);
+      res |= static_cast<std::size_t>(byte & 0x7f) << shift;
+      if (byte < 0x80) return res;
+    }
+  }
+
+  static std::size_t common_prefix(const char* x, std::size_t x_size,
+                                   const char* y, std::size_t y_size,
+                                   std::size_t from) {
+    std::size_t n = std::min(x_size, y_size);
+    while (from != n && x[from] == y[from]) ++from;
+    return from;
+  }
+
+  // Whether key goes before q (key < q, or key <= q for upper bounds),
+  // given that they share at least `known` characters. Stores how many
+  // they actually share in `shared`.
+  static bool precedes(key_ref key, key_ref q, bool upper, std::size_t known,
+                       std::size_t& shared) {
+    shared = common_prefix(key.data, key.size, q.data, q.size, known);
+    if (shared == q.size) return upper && key.size == q.size;
+    if (shared == key.size) return true;
+    return static_cast<unsigned char>(key.data[shared]) <
+           static_cast<unsigned char>(q.data[shared]);
+  }
+
+  key_ref head(std::size_t block) const {
+    const char* p = arena_.data() + heads_[block];
+    std::size_t size = read_varint(p);
+    return {p, size};
+  }
+
+  static bool equal(key_ref x, key_ref y) {
+    return x.size == y.size && std::memcmp(x.data, y.data, x.size) == 0;
+  }
+
+  // For lower bounds, also tells if the answer is equal to q.
+  std::size_t bound(key_ref q, bool upper, bool* found = nullptr) const {
+    // Last block whose head goes before q.
+    std::size_t lo_shared = 0;
+    std::size_t hi_shared = 0;
+    std::size_t shared = 0;
+    auto head_precedes = [&](std::size_t offset) {
+      const char* p = arena_.data() + offset;
+      std::size_t size = read_varint(p);
+      std::size_t s;
+      bool res =
+          precedes({p, size}, q, upper, std::min(lo_shared, hi_shared), s);
+      (res ? lo_shared : hi_shared) = s;
+      return res;
+    };
+    auto blocks_before =
+        partition_point_n(heads_.begin(),
+                          static_cast<std::ptrdiff_t>(heads_.size()),
+                          head_precedes) -
+        heads_.begin();
+    if (blocks_before == 0) {
+      if (found) *found = size_ != 0 && equal(head(0), q);
+      return 0;
+    }
+
+    std::size_t block = static_cast<std::size_t>(blocks_before) - 1;
+    key_ref prev = head(block);
+    precedes(prev, q, upper, lo_shared, shared);
+
+    // Keys are decoded into buf, since they are only stored as suffixes.
+    std::string buf(prev.data, prev.size);
+    const char* p = prev.data + prev.size;
+    std::size_t rank = block * block_size_;
+    std::size_t last = std::min(rank + block_size_, size_);
+
+    for (++rank; rank != last; ++rank) {
+      std::size_t prefix = read_varint(p);
+      std::size_t suffix = read_varint(p);
+      buf.resize(prefix);
+      buf.append(p, suffix);
+      p += suffix;
+
+      if (prefix > shared) continue;
+      if (prefix < shared) return rank;
+      if (!precedes({buf.data(), buf.size()}, q, upper, shared, shared)) {
+        if (found) *found = shared == q.size && buf.size() == q.size;
+        return rank;
+      }
+    }
+    if (found) *found = rank != size_ && equal(head(rank / block_size_), q);
+    return rank;
+  }
+
+ public:
+  static constexpr std::size_t kDefaultBlockSize = 16;
+
+  prefix_compressed_keys() = default;
+
+  // [f, l) is sorted.
+  template <typename I>
+  // requires ForwardIterator<I> && ValueType<I> == std::string
+  prefix_compressed_keys(I f, I l, std::size_t block_size = kDefaultBlockSize)
+      : block_size_(std::max<std::size_t>(block_size, 1)) {
+    const std::string* prev = nullptr;
+    for (; f != l; ++f, ++size_) {
+      const std::string& key = *f;
+      if (size_ % block_size_ == 0) {
+        heads_.push_back(arena_.size());
+        write_varint(key.size());
+        arena_.insert(arena_.end(), key.begin(), key.end());
+      } else {
+        std::size_t prefix = common_prefix(prev->data(), prev->size(),
+                                           key.data(), key.size(), 0);
+        write_varint(prefix);
+        write_varint(key.size() - prefix);
+        arena_.insert(arena_.end(),
+                      key.begin() + static_cast<std::ptrdiff_t>(prefix),
+                      key.end());
+      }
+      prev = &key;
+    }
+    arena_.shrink_to_fit();
+    heads_.shrink_to_fit();
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t block_size() const { return block_size_; }
+
+  std::size_t memory_usage() const {
+    return sizeof(*this) + arena_.capacity() +
+           heads_.capacity() * sizeof(std::size_t);
+  }
+
+  // Decodes the key at rank i: walks its block from the head.
+  std::string operator[](std::size_t i) const {
+    key_ref h = head(i / block_size_);
+    std::string res(h.data, h.size);
+    const char* p = h.data + h.size;
+    for (std::size_t j = i % block_size_; j != 0; --j) {
+      std::size_t prefix = read_varint(p);
+      std::size_t suffix = read_varint(p);
+      res.resize(prefix);
+      res.append(p, suffix);
+      p += suffix;
+    }
+    return res;
+  }
+
+  std::size_t lower_bound(const std::string& q) const {
+    return bound({q.data(), q.size()}, false);
+  }
+
+  std::size_t upper_bound(const std::string& q) const {
+    return bound({q.data(), q.size()}, true);
+  }
+
+  std::pair<std::size_t, std::size_t> equal_range(const std::string& q) const {
+    return {lower_bound(q), upper_bound(q)};
+  }
+
+  bool contains(const std::string& q) const {
+    bool found = false;
+    bound({q.data(), q.size()}, false, &found);
+    return found;
+  }
+};
+
+}  // namespace srt
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "prefix_compressed_keys.h"
+
+namespace {
+
+constexpr std::size_t kKeysCount = 1u << 18;
+constexpr std::size_t kQueriesCount = 1u << 16;
+
+enum key_kind : int {
+  kUrls = 0,   // https://www.<host>.com/<section>/<page>
+  kPaths = 1,  // /usr/<dir>/<dir>/<file>.<ext>, deep shared prefixes
+};
+
+std::string random_word(std::mt19937& g, std::size_t min, std::size_t max) {
+  std::uniform_int_distribution<std::size_t> length(min, max);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::string res(length(g), ' ');
+  for (char& c : res) c = static_cast<char>(letter(g));
+  return res;
+}
+
+std::vector<std::string> words(std::mt19937& g, std::size_t count,
+                               std::size_t min, std::size_t max) {
+  std::vector<std::string> res(count);
+  for (auto& w : res) w = random_word(g, min, max);
+  return res;
+}
+
+std::vector<std::string> sorted_keys(int kind) {
+  std::mt19937 g;
+  std::vector<std::string> res(kKeysCount);
+
+  if (kind == kUrls) {
+    const auto hosts = words(g, 2000, 4, 12);
+    const auto sections = words(g, 50, 3, 10);
+    std::uniform_int_distribution<std::size_t> host(0, hosts.size() - 1);
+    std::uniform_int_distribution<std::size_t> section(0, sections.size() - 1);
+    for (auto& key : res)
+      key = "https://www." + hosts[host(g)] + ".com/" + sections[section(g)] +
+            "/" + random_word(g, 5, 20);
+  } else {
+    const auto dirs = words(g, 30, 2, 8);
+    const char* extensions[] = {".h", ".cc", ".txt", ".so"};
+    std::uniform_int_distribution<std::size_t> dir(0, dirs.size() - 1);
+    std::uniform_int_distribution<std::size_t> extension(0, 3);
+    for (auto& key : res)
+      key = "/usr/" + dirs[dir(g)] + "/" + dirs[dir(g)] + "/" +
+            dirs[dir(g)] + "/" + random_word(g, 3, 12) +
+            extensions[extension(g)];
+  }
+
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+std::size_t vector_memory_usage(const std::vector<std::string>& keys) {
+  std::size_t res = sizeof(keys) + keys.capacity() * sizeof(std::string);
+  const std::string empty;
+  for (const auto& key : keys)
+    if (key.capacity() > empty.capacity()) res += key.capacity() + 1;
+  return res;
+}
+
+void set_kind(benchmark::internal::Benchmark* bench) {
+  for (int kind : {kUrls, kPaths}) bench->Arg(kind);
+}
+
+void set_kind_and_block_size(benchmark::internal::Benchmark* bench) {
+  for (int kind : {kUrls, kPaths})
+    for (int block_size : {8, 16, 32, 64}) bench->Args({kind, block_size});
+}
+
+// Half of the queries are keys, half are keys with a letter changed.
+template <typename Searcher>
+void run_lookups(benchmark::State& state, const std::vector<std::string>& keys,
+                 Searcher searcher) {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::size_t> dis(0, keys.size() - 1);
+  std::vector<std::string> queries(kQueriesCount);
+  for (std::size_t i = 0; i != queries.size(); ++i) {
+    queries[i] = keys[dis(g)];
+    if (i % 2) queries[i].back() = 'm';
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(searcher(queries[i]));
+    i = (i + 1) % queries.size();
+  }
+}
+
+}  // namespace
+
+void benchmark_string_lookup_std(benchmark::State& state) {
+  const auto keys = sorted_keys(static_cast<int>(state.range(0)));
+  run_lookups(state, keys, [&](const std::string& q) {
+    return std::lower_bound(keys.begin(), keys.end(), q);
+  });
+  state.counters["bytes_per_key"] =
+      static_cast<double>(vector_memory_usage(keys)) /
+      static_cast<double>(keys.size());
+}
+
+void benchmark_string_lookup_prefix_compressed(benchmark::State& state) {
+  const auto keys = sorted_keys(static_cast<int>(state.range(0)));
+  const srt::prefix_compressed_keys compressed(
+      keys.begin(), keys.end(), static_cast<std::size_t>(state.range(1)));
+  run_lookups(state, keys,
+              [&](const std::string& q) { return compressed.lower_bound(q); });
+  state.counters["bytes_per_key"] =
+      static_cast<double>(compressed.memory_usage()) /
+      static_cast<double>(keys.size());
+}
+
+BENCHMARK(benchmark_string_lookup_std)->Apply(set_kind);
+BENCHMARK(benchmark_string_lookup_prefix_compressed)
+    ->Apply(set_kind_and_block_size);
@@ -0,0 +1,71 @@
+#include "prefix_compressed_keys.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Short keys over a small alphabet, so that there are many shared
+// prefixes, keys that are prefixes of other keys, and duplicates.
+std::vector<std::string> random_keys(std::mt19937& g, std::size_t size) {
+  std::uniform_int_distribution<std::size_t> length(0, 6);
+  std::uniform_int_distribution<int> letter('a', 'c');
+  std::vector<std::string> res(size);
+  for (auto& key : res) {
+    key.resize(length(g));
+    for (char& c : key) c = static_cast<char>(letter(g));
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+}  // namespace
+
+TEST_CASE("prefix_compressed_keys", "[prefix_compressed_keys]") {
+  std::mt19937 g;
+
+  for (std::size_t size = 0; size < 120; size += 7) {
+    const auto keys = random_keys(g, size);
+    const auto queries = random_keys(g, 200);
+
+    for (std::size_t block_size : {1, 2, 3, 16, 200}) {
+      const srt::prefix_compressed_keys compressed(keys.begin(), keys.end(),
+                                                   block_size);
+      REQUIRE(compressed.size() == keys.size());
+      for (std::size_t i = 0; i != keys.size(); ++i)
+        REQUIRE(compressed[i] == keys[i]);
+
+      for (const auto& q : queries) {
+        auto lb = static_cast<std::size_t>(
+            std::lower_bound(keys.begin(), keys.end(), q) - keys.begin());
+        auto ub = static_cast<std::size_t>(
+            std::upper_bound(keys.begin(), keys.end(), q) - keys.begin());
+
+        REQUIRE(compressed.lower_bound(q) == lb);
+        REQUIRE(compressed.upper_bound(q) == ub);
+        REQUIRE(compressed.equal_range(q) == std::make_pair(lb, ub));
+        REQUIRE(compressed.contains(q) == (lb != ub));
+      }
+    }
+  }
+}
+
+TEST_CASE("prefix_compressed_keys_bytes", "[prefix_compressed_keys]") {
+  // Characters outside of ASCII compare as unsigned, like std::string.
+  std::vector<std::string> keys = {"", std::string(200, 'a'), "a\x80", "\xff"};
+  std::sort(keys.begin(), keys.end());
+
+  const srt::prefix_compressed_keys compressed(keys.begin(), keys.end(), 2);
+  for (std::size_t i = 0; i != keys.size(); ++i) {
+    REQUIRE(compressed[i] == keys[i]);
+    REQUIRE(compressed.lower_bound(keys[i]) == i);
+    REQUIRE(compressed.contains(keys[i]));
+  }
+  REQUIRE(compressed.lower_bound("a\x7f") == 2);
+  REQUIRE(compressed.lower_bound(std::string(201, 'a')) == 2);
+  REQUIRE(!compressed.contains("a"));
+  REQUIRE(compressed.upper_bound("\xff\xff") == keys.size());
+}
@@ -1,6 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace srt {
 
@@ -13,6 +25,77 @@ struct less {
   using is_transparent = int;
 };
 
+// A three-way comparator c(x, v) returns a negative number, 0 or a
+// positive one, like strcmp. Wrapped with three_way(), it is still a
+// "less" for every algorithm here, but the equal_range_n,
+// equal_range_biased and equal_range_hinted overloads for it tell apart
+// "less", "equal" and "greater" with one call per probe, rather than
+// p(x, v) and p(v, x).
+//
+// The algorithms call a "less" both ways: upper_bound and the set
+// algorithms do p(v, x). c only has to take one order: when c(x, y)
+// does not compile, c(y, x) is called and its sign flipped.
+template <typename C>
+struct three_way_compare {
+  C c;
+
+  template <typename X, typename Y>
+  int compare(const X& x, const Y& y) {
+    return compare(x, y, 0);
+  }
+
+  template <typename X, typename Y>
+  bool operator()(const X& x, const Y& y) {
+    return compare(x, y, 0) < 0;
+  }
+
+ private:
+  template <typename X, typename Y>
+  auto compare(const X& x, const Y& y, int)
+      -> decltype(std::declval<C&>()(x, y), int{}) {
+    auto r = c(x, y);
+    return r < 0 ? -1 : r > 0 ? 1 : 0;
+  }
+
+  template <typename X, typename Y>
+  int compare(const X& x, const Y& y, long) {
+    auto r = c(y, x);
+    return r < 0 ? 1 : r > 0 ? -1 : 0;
+  }
+};
+
+template <typename C>
+three_way_compare<C> three_way(C c) {
+  return {c};
+}
+
+// x.compare(v), as in std::string.
+struct compare_member {
+  template <typename X, typename Y>
+  auto operator()(const X& x, const Y& y) -> decltype(x.compare(y)) {
+    return x.compare(y);
+  }
+};
+
+template <typename T, typename V, typename = void>
+struct default_compare_impl {
+  using type = less;
+};
+
+template <typename T, typename V>
+struct default_compare_impl<
+    T, V,
+    typename std::enable_if<std::is_convertible<
+        decltype(std::declval<const T&>().compare(std::declval<const V&>())),
+        int>::value>::type> {
+  using type = three_way_compare<compare_member>;
+};
+
+// What the equal_range functions use without a comparator: three-way
+// if T has a compare(V) member, otherwise less.
+template <typename T, typename V>
+using default_compare = typename default_compare_impl<T, V>::type;
+
 template <typename I>
 using DifferenceType = typename std::iterator_traits<I>::difference_type;
 
@@ -27,6 +110,9 @@ constexpr bool is_bidirectional_v =
 template <typename I>
 using Reference = typename std::iterator_traits<I>::reference;
 
+template <typename I>
+using ValueType = typename std::iterator_traits<I>::value_type;
+
 template <typename I>
 // requires ForwardIterator<I>
 void advance_checked(I& f, I l, DifferenceType<I>& n,
@@ -115,7 +201,7 @@ std::pair<I, I> equal_range_n(I f, DifferenceType<I> n, const V& v, P p) {
 template <typename I, typename V>
 // requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
 std::pair<I, I> equal_range_n(I f, DifferenceType<I> n, const V& v) {
-  return equal_range_n(f, n, v, less{});
+  return equal_range_n(f, n, v, default_compare<ValueType<I>, V>{});
 }
 
 template <typename I, typename P>
@@ -175,9 +261,59 @@ std::pair<I, I> equal_range_biased_expensive_cmp(I f, I l, const V& v) {
   return equal_range_biased_expensive_cmp(f, l, v, less{});
 }
 
+// Galloping over a forward range walks to the end of a window to test
+// it and then would have to walk the window again to bisect it. Instead,
+// the iterators of the window are kept while walking it, so every
+// element is passed at most once. Windows of up to kSinglePassWindow
+// elements are kept on the stack, bigger ones in a heap buffer: this can
+// throw std::bad_alloc.
+//
+// Walk(f, buf, step) stores iterators to the next (up to) step elements
+// in buf, moves f past them and returns how many there were.
+// BufferSize(step) is called when the window for step may not fit the
+// buffer and returns the size to grow it to.
+
+constexpr std::ptrdiff_t kSinglePassWindow = 16;
+
+template <typename I, typename P, typename Walk, typename BufferSize>
+// requires ForwardIterator<I> && Predicate<P(ValueType<I>)>
+I partition_point_biased_single_pass(I f, P p, Walk walk,
+                                     BufferSize buffer_size) {
+  std::array<I, kSinglePassWindow> small;
+  std::vector<I> big;
+  I* buf = small.data();
+  DifferenceType<I> capacity = kSinglePassWindow;
+
+  for (DifferenceType<I> step = 1;; step += step) {
+    if (step > capacity) {
+      DifferenceType<I> size = buffer_size(step);
+      if (size > capacity) {
+        big.resize(static_cast<std::size_t>(size));
+        buf = big.data();
+        capacity = size;
+      }
+    }
+
+    DifferenceType<I> walked = walk(f, buf, step);
+    if (walked == 0) return f;
+    if (!p(*buf[walked - 1]))
+      return *partition_point_n(buf, walked - 1,
+                                [&](const I& it) { return p(*it); });
+    if (walked != step) return f;
+  }
+}
+
 template <typename I, typename P>
+// requires ForwardIterator<I> && Predicate<P(ValueType<I>)>
 I partition_point_biased(I f, I l, P p, std::forward_iterator_tag) {
-  return partition_point_biased_expensive_pred(f, l, p);
+  return partition_point_biased_single_pass(
+      f, p,
+      [&](I& f, I* buf, DifferenceType<I> step) {
+        DifferenceType<I> walked = 0;
+        for (; walked != step && f != l; ++walked, ++f) buf[walked] = f;
+        return walked;
+      },
+      [](DifferenceType<I> step) { return step; });
 }
 
 template <typename I>
@@ -222,22 +358,327 @@ I partition_point_biased(I f, I l, P p) {
   return partition_point_biased(f, l, p, IteratorCategory<I>{});
 }
 
+// Counted versions: for forward iterators, when the length is known,
+// there is no need to compare with the end on every step, and the heap
+// buffer of the single pass gallop is allocated at most once: big
+// enough for every window that is left.
+
+template <typename I, typename P>
+// requires ForwardIterator<I> && Predicate<P(ValueType<I>)>
+I partition_point_biased_n(I f, DifferenceType<I> n, P p,
+                           std::forward_iterator_tag) {
+  return partition_point_biased_single_pass(
+      f, p,
+      [&](I& f, I* buf, DifferenceType<I> step) {
+        DifferenceType<I> walked = std::min(step, n);
+        n -= walked;
+        for (DifferenceType<I> i = 0; i != walked; ++i, ++f) buf[i] = f;
+        return walked;
+      },
+      [&](DifferenceType<I> step) {
+        DifferenceType<I> res = 0;
+        for (DifferenceType<I> left = n; left != 0; step += step) {
+          DifferenceType<I> window = std::min(step, left);
+          res = std::max(res, window);
+          left -= window;
+        }
+        return res;
+      });
+}
+
+template <typename I, typename P>
+// requires RandomAccessIterator<I> && Predicate<P(ValueType<I>)>
+I partition_point_biased_n(I f, DifferenceType<I> n, P p,
+                           std::random_access_iterator_tag) {
+  return partition_point_biased(f, f + n, p);
+}
+
+template <typename I, typename P>
+// requires ForwardIterator<I> && Predicate<P(ValueType<I>)>
+I partition_point_biased_n(I f, DifferenceType<I> n, P p) {
+  return partition_point_biased_n(f, n, p, IteratorCategory<I>{});
+}
+
 template <typename I, typename V, typename P>
 // requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>, V)>
-I lower_bound_biased(I f, I l, const V& v, P p) {
+I lower_bound_biased_n(I f, DifferenceType<I> n, const V& v, P p) {
+  return partition_point_biased_n(f, n,
+                                  [&](Reference<I> x) { return p(x, v); });
+}
+
+template <typename I, typename V>
+// requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
+I lower_bound_biased_n(I f, DifferenceType<I> n, const V& v) {
+  return lower_bound_biased_n(f, n, v, less{});
+}
+
+template <typename I, typename V, typename P>
+// requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>, V)>
+I upper_bound_biased_n(I f, DifferenceType<I> n, const V& v, P p) {
+  return partition_point_biased_n(f, n,
+                                  [&](Reference<I> x) { return !p(v, x); });
+}
+
+template <typename I, typename V>
+// requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
+I upper_bound_biased_n(I f, DifferenceType<I> n, const V& v) {
+  return upper_bound_biased_n(f, n, v, less{});
+}
+
+// SIMD kernels for the linear prefix of lower/upper_bound_biased.
+// less_mask/greater_mask return a bit per element of [f, f + width):
+// x < v and v < x respectively.
+// Types without a kernel for the enabled instruction set have width 0.
+
+template <typename T>
+struct simd_traits {
+  static constexpr int width = 0;
+};
+
+#if defined(__AVX2__)
+
+template <>
+struct simd_traits<std::int32_t> {
+  static constexpr int width = 8;
+
+  static unsigned less_mask(const std::int32_t* f, std::int32_t v) {
+    __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f));
+    __m256i cmp = _mm256_cmpgt_epi32(_mm256_set1_epi32(v), xs);
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(cmp)));
+  }
+
+  static unsigned greater_mask(const std::int32_t* f, std::int32_t v) {
+    __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f));
+    __m256i cmp = _mm256_cmpgt_epi32(xs, _mm256_set1_epi32(v));
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(cmp)));
+  }
+};
+
+template <>
+struct simd_traits<std::int64_t> {
+  static constexpr int width = 4;
+
+  static unsigned less_mask(const std::int64_t* f, std::int64_t v) {
+    __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f));
+    __m256i cmp = _mm256_cmpgt_epi64(_mm256_set1_epi64x(v), xs);
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(cmp)));
+  }
+
+  static unsigned greater_mask(const std::int64_t* f, std::int64_t v) {
+    __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f));
+    __m256i cmp = _mm256_cmpgt_epi64(xs, _mm256_set1_epi64x(v));
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(cmp)));
+  }
+};
+
+template <>
+struct simd_traits<float> {
+  static constexpr int width = 8;
+
+  static unsigned less_mask(const float* f, float v) {
+    __m256 cmp = _mm256_cmp_ps(_mm256_loadu_ps(f), _mm256_set1_ps(v), _CMP_LT_OQ);
+    return static_cast<unsigned>(_mm256_movemask_ps(cmp));
+  }
+
+  static unsigned greater_mask(const float* f, float v) {
+    __m256 cmp = _mm256_cmp_ps(_mm256_set1_ps(v), _mm256_loadu_ps(f), _CMP_LT_OQ);
+    return static_cast<unsigned>(_mm256_movemask_ps(cmp));
+  }
+};
+
+template <>
+struct simd_traits<double> {
+  static constexpr int width = 4;
+
+  static unsigned less_mask(const double* f, double v) {
+    __m256d cmp = _mm256_cmp_pd(_mm256_loadu_pd(f), _mm256_set1_pd(v), _CMP_LT_OQ);
+    return static_cast<unsigned>(_mm256_movemask_pd(cmp));
+  }
+
+  static unsigned greater_mask(const double* f, double v) {
+    __m256d cmp = _mm256_cmp_pd(_mm256_set1_pd(v), _mm256_loadu_pd(f), _CMP_LT_OQ);
+    return static_cast<unsigned>(_mm256_movemask_pd(cmp));
+  }
+};
+
+#elif defined(__SSE2__)
+
+template <>
+struct simd_traits<std::int32_t> {
+  static constexpr int width = 4;
+
+  static unsigned less_mask(const std::int32_t* f, std::int32_t v) {
+    __m128i xs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f));
+    __m128i cmp = _mm_cmplt_epi32(xs, _mm_set1_epi32(v));
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(cmp)));
+  }
+
+  static unsigned greater_mask(const std::int32_t* f, std::int32_t v) {
+    __m128i xs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f));
+    __m128i cmp = _mm_cmpgt_epi32(xs, _mm_set1_epi32(v));
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(cmp)));
+  }
+};
+
+#if defined(__SSE4_2__)
+template <>
+struct simd_traits<std::int64_t> {
+  static constexpr int width = 2;
+
+  static unsigned less_mask(const std::int64_t* f, std::int64_t v) {
+    __m128i xs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f));
+    __m128i cmp = _mm_cmpgt_epi64(_mm_set1_epi64x(v), xs);
+    return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(cmp)));
+  }
+
+  static unsigned greater_mask(const std::int64_t* f, std::int64_t v) {
+    __m128i xs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f));
+    __m128i cmp = _mm_cmpgt_epi64(xs, _mm_set1_epi64x(v));
+    return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(cmp)));
+  }
+};
+#endif  // defined(__SSE4_2__)
+
+template <>
+struct simd_traits<float> {
+  static constexpr int width = 4;
+
+  static unsigned less_mask(const float* f, float v) {
+    __m128 cmp = _mm_cmplt_ps(_mm_loadu_ps(f), _mm_set1_ps(v));
+    return static_cast<unsigned>(_mm_movemask_ps(cmp));
+  }
+
+  static unsigned greater_mask(const float* f, float v) {
+    __m128 cmp = _mm_cmplt_ps(_mm_set1_ps(v), _mm_loadu_ps(f));
+    return static_cast<unsigned>(_mm_movemask_ps(cmp));
+  }
+};
+
+template <>
+struct simd_traits<double> {
+  static constexpr int width = 2;
+
+  static unsigned less_mask(const double* f, double v) {
+    __m128d cmp = _mm_cmplt_pd(_mm_loadu_pd(f), _mm_set1_pd(v));
+    return static_cast<unsigned>(_mm_movemask_pd(cmp));
+  }
+
+  static unsigned greater_mask(const double* f, double v) {
+    __m128d cmp = _mm_cmplt_pd(_mm_set1_pd(v), _mm_loadu_pd(f));
+    return static_cast<unsigned>(_mm_movemask_pd(cmp));
+  }
+};
+
+#endif  // defined(__AVX2__)
+
+// How far the vectorized linear scan goes before we start galloping.
+constexpr std::ptrdiff_t kSimdLinearPrefixBytes = 256;
+
+// Precondition: [f, l) is partitioned by p (sorted, for the bound
+// kernels below). The position of the partition point in a register is
+// the popcount of its mask, not the index of its first set bit: the two
+// only agree because every element that satisfies p comes first. On
+// input that is not partitioned the result is meaningless.
+template <typename T, typename Count, typename P>
+// requires simd_traits<T>::width != 0 &&
+//          Count(const T*) returns the number of elements in [f, f + width)
+//          that satisfy P
+const T* partition_point_biased_simd(const T* f, const T* l, Count count_in,
+                                     P p) {
+  constexpr int width = simd_traits<T>::width;
+  const T* prefix_l =
+      f + std::min(l - f, kSimdLinearPrefixBytes / std::ptrdiff_t(sizeof(T)));
+  if (prefix_l - f < width) return partition_point_biased(f, l, p);
+
+  std::ptrdiff_t count = count_in(f);
+  if (count != width) return f + count;
+
+  // The input is partitioned, so summing the counts over the rest of
+  // the prefix gives the answer without a branch per register.
+  std::ptrdiff_t scanned = width;
+  for (; prefix_l - f - scanned >= width; scanned += width)
+    count += count_in(f + scanned);
+  if (count != scanned) return f + count;
+
+  return partition_point_biased(f + scanned, l, p);
+}
+
+template <typename T>
+// requires simd_traits<T>::width != 0
+const T* lower_bound_biased_simd(const T* f, const T* l, T v) {
+  return partition_point_biased_simd(
+      f, l,
+      [&](const T* block) {
+        return __builtin_popcount(simd_traits<T>::less_mask(block, v));
+      },
+      [&](const T& x) { return x < v; });
+}
+
+template <typename T>
+// requires simd_traits<T>::width != 0
+const T* upper_bound_biased_simd(const T* f, const T* l, T v) {
+  return partition_point_biased_simd(
+      f, l,
+      [&](const T* block) {
+        return simd_traits<T>::width -
+               __builtin_popcount(simd_traits<T>::greater_mask(block, v));
+      },
+      [&](const T& x) { return !(v < x); });
+}
+
+template <typename I, typename T>
+constexpr bool is_contiguous_iterator_v =
+    std::is_same<I, T*>::value || std::is_same<I, const T*>::value ||
+    std::is_same<I, typename std::vector<T>::iterator>::value ||
+    std::is_same<I, typename std::vector<T>::const_iterator>::value;
+
+// Whether lower/upper_bound_biased(f, l, v, p) can use the simd kernels.
+template <typename I, typename V, typename P,
+          typename T = typename std::iterator_traits<I>::value_type>
+using use_simd_biased_search = std::integral_constant<
+    bool, (simd_traits<T>::width != 0) && is_contiguous_iterator_v<I, T> &&
+              std::is_same<V, T>::value && std::is_same<P, less>::value>;
+
+template <typename I, typename V, typename P>
+I lower_bound_biased(I f, I l, const V& v, P p, std::false_type /*simd*/) {
   return partition_point_biased(f, l, [&](Reference<I> x) { return p(x, v); });
 }
 
+template <typename I, typename V, typename P>
+I lower_bound_biased(I f, I l, const V& v, P, std::true_type /*simd*/) {
+  if (f == l) return f;
+  const V* ptr = &*f;
+  return f + (lower_bound_biased_simd(ptr, ptr + (l - f), v) - ptr);
+}
+
+template <typename I, typename V, typename P>
+// requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>, V)>
+I lower_bound_biased(I f, I l, const V& v, P p) {
+  return lower_bound_biased(f, l, v, p, use_simd_biased_search<I, V, P>{});
+}
+
 template <typename I, typename V>
 // requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
 I lower_bound_biased(I f, I l, const V& v) {
   return lower_bound_biased(f, l, v, less{});
 }
 
+template <typename I, typename V, typename P>
+I upper_bound_biased(I f, I l, const V& v, P p, std::false_type /*simd*/) {
+  return partition_point_biased(f, l, [&](Reference<I> x) { return !p(v, x); });
+}
+
+template <typename I, typename V, typename P>
+I upper_bound_biased(I f, I l, const V& v, P, std::true_type /*simd*/) {
+  if (f == l) return f;
+  const V* ptr = &*f;
+  return f + (upper_bound_biased_simd(ptr, ptr + (l - f), v) - ptr);
+}
+
 template <typename I, typename V, typename P>
 // requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>, V)>
 I upper_bound_biased(I f, I l, const V& v, P p) {
-  return partition_point_biased(f, l, [&](Reference<I> x) { return !p(v, x); });
+  return upper_bound_biased(f, l, v, p, use_simd_biased_search<I, V, P>{});
 }
 
 template <typename I, typename V>
@@ -257,7 +698,525 @@ std::pair<I, I> equal_range_biased(I f, I l, const V& v, P p) {
 template <typename I, typename V>
 // requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
 std::pair<I, I> equal_range_biased(I f, I l, const V& v) {
-  return equal_range_biased(f, l, v, less{});
+  return equal_range_biased(f, l, v, default_compare<ValueType<I>, V>{});
+}
+
+// Batched searches for sorted needles: every search starts from the
+// previous result, so the batch costs O(sum log(gap)) comparisons.
+
+template <typename I, typename J, typename O, typename P>
+// requires ForwardIterator<I> && InputIterator<J> && OutputIterator<O, I> &&
+//          StrictWeakOrder<P(ValueType<I>, ValueType<J>)>
+O lower_bound_biased_batch(I f, I l, J needles_f, J needles_l, O out, P p) {
+  for (; needles_f != needles_l; ++needles_f) {
+    f = lower_bound_biased(f, l, *needles_f, p);
+    *out = f;
+    ++out;
+  }
+  return out;
+}
+
+template <typename I, typename J, typename O>
+// requires ForwardIterator<I> && InputIterator<J> && OutputIterator<O, I> &&
+//          WeakComarable<ValueType<I>, ValueType<J>>
+O lower_bound_biased_batch(I f, I l, J needles_f, J needles_l, O out) {
+  return lower_bound_biased_batch(f, l, needles_f, needles_l, out, less{});
+}
+
+template <typename I, typename J, typename O, typename P>
+// requires ForwardIterator<I> && InputIterator<J> && OutputIterator<O, I> &&
+//          StrictWeakOrder<P(ValueType<I>, ValueType<J>)>
+O upper_bound_biased_batch(I f, I l, J needles_f, J needles_l, O out, P p) {
+  for (; needles_f != needles_l; ++needles_f) {
+    f = upper_bound_biased(f, l, *needles_f, p);
+    *out = f;
+    ++out;
+  }
+  return out;
+}
+
+template <typename I, typename J, typename O>
+// requires ForwardIterator<I> && InputIterator<J> && OutputIterator<O, I> &&
+//          WeakComarable<ValueType<I>, ValueType<J>>
+O upper_bound_biased_batch(I f, I l, J needles_f, J needles_l, O out) {
+  return upper_bound_biased_batch(f, l, needles_f, needles_l, out, less{});
+}
+
+template <typename I, typename J, typename O, typename P>
+// requires ForwardIterator<I> && InputIterator<J> &&
+//          OutputIterator<O, std::pair<I, I>> &&
+//          StrictWeakOrder<P(ValueType<I>, ValueType<J>)>
+O equal_range_biased_batch(I f, I l, J needles_f, J needles_l, O out, P p) {
+  for (; needles_f != needles_l; ++needles_f) {
+    auto r = equal_range_biased(f, l, *needles_f, p);
+    f = r.first;  // the next needle can be equal to this one.
+    *out = r;
+    ++out;
+  }
+  return out;
+}
+
+template <typename I, typename J, typename O>
+// requires ForwardIterator<I> && InputIterator<J> &&
+//          OutputIterator<O, std::pair<I, I>> &&
+//          WeakComarable<ValueType<I>, ValueType<J>>
+O equal_range_biased_batch(I f, I l, J needles_f, J needles_l, O out) {
+  return equal_range_biased_batch(f, l, needles_f, needles_l, out, less{});
+}
+
+// Set algorithms that skip over the non matching runs with
+// lower_bound_biased, so the number of comparisons adapts to how the
+// inputs interleave: O(n + m) at worst, O(m log(n / m)) for a small
+// second range. Output matches the std:: algorithms, duplicates included.
+//
+// After a comparison we know that the current element is not the answer,
+// so the searches start from the next one.
+
+template <typename I1, typename I2, typename O, typename P>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          StrictWeakOrder<P(ValueType<I1>, ValueType<I2>)>
+O set_intersection_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out, P p) {
+  while (f1 != l1 && f2 != l2) {
+    if (p(*f1, *f2)) {
+      f1 = lower_bound_biased(std::next(f1), l1, *f2, p);
+    } else if (p(*f2, *f1)) {
+      f2 = lower_bound_biased(std::next(f2), l2, *f1, p);
+    } else {
+      *out = *f1;
+      ++out;
+      ++f1;
+      ++f2;
+    }
+  }
+  return out;
+}
+
+template <typename I1, typename I2, typename O>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          WeakComarable<ValueType<I1>, ValueType<I2>>
+O set_intersection_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out) {
+  return set_intersection_biased(f1, l1, f2, l2, out, less{});
+}
+
+template <typename I1, typename I2, typename O, typename P>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          StrictWeakOrder<P(ValueType<I1>, ValueType<I2>)>
+O set_difference_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out, P p) {
+  while (f1 != l1 && f2 != l2) {
+    if (p(*f1, *f2)) {
+      I1 m = lower_bound_biased(std::next(f1), l1, *f2, p);
+      out = std::copy(f1, m, out);
+      f1 = m;
+    } else if (p(*f2, *f1)) {
+      f2 = lower_bound_biased(std::next(f2), l2, *f1, p);
+    } else {
+      ++f1;
+      ++f2;
+    }
+  }
+  return std::copy(f1, l1, out);
+}
+
+template <typename I1, typename I2, typename O>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          WeakComarable<ValueType<I1>, ValueType<I2>>
+O set_difference_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out) {
+  return set_difference_biased(f1, l1, f2, l2, out, less{});
+}
+
+template <typename I1, typename I2, typename O, typename P>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          StrictWeakOrder<P(ValueType<I1>, ValueType<I2>)>
+O set_union_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out, P p) {
+  while (f1 != l1 && f2 != l2) {
+    if (p(*f2, *f1)) {
+      I2 m = lower_bound_biased(std::next(f2), l2, *f1, p);
+      out = std::copy(f2, m, out);
+      f2 = m;
+    } else if (p(*f1, *f2)) {
+      I1 m = lower_bound_biased(std::next(f1), l1, *f2, p);
+      out = std::copy(f1, m, out);
+      f1 = m;
+    } else {
+      *out = *f1;
+      ++out;
+      ++f1;
+      ++f2;
+    }
+  }
+  return std::copy(f2, l2, std::copy(f1, l1, out));
+}
+
+template <typename I1, typename I2, typename O>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          WeakComarable<ValueType<I1>, ValueType<I2>>
+O set_union_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out) {
+  return set_union_biased(f1, l1, f2, l2, out, less{});
+}
+
+template <typename I1, typename I2, typename P>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          StrictWeakOrder<P(ValueType<I1>, ValueType<I2>)>
+bool includes_biased(I1 f1, I1 l1, I2 f2, I2 l2, P p) {
+  while (f2 != l2) {
+    if (f1 == l1 || p(*f2, *f1)) return false;
+    if (p(*f1, *f2)) {
+      f1 = lower_bound_biased(std::next(f1), l1, *f2, p);
+    } else {
+      ++f1;
+      ++f2;
+    }
+  }
+  return true;
+}
+
+template <typename I1, typename I2>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          WeakComarable<ValueType<I1>, ValueType<I2>>
+bool includes_biased(I1 f1, I1 l1, I2 f2, I2 l2) {
+  return includes_biased(f1, l1, f2, l2, less{});
+}
+
+// Timsort style merge: compares elements one by one until one side wins
+// kMinGallop times in a row, then copies whole blocks found with
+// upper/lower_bound_biased until the blocks get short again.
+// Stable: of the equivalent elements the ones from [f1, l1) go first.
+
+constexpr std::ptrdiff_t kMinGallop = 7;
+
+template <typename I1, typename I2, typename O, typename P>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          StrictWeakOrder<P(ValueType<I1>, ValueType<I2>)>
+std::tuple<I1, I2, O> merge_biased_until_one_is_empty(I1 f1, I1 l1, I2 f2,
+                                                      I2 l2, O out, P p) {
+  while (f1 != l1 && f2 != l2) {
+    std::ptrdiff_t wins1 = 0;
+    std::ptrdiff_t wins2 = 0;
+    while (wins1 < kMinGallop && wins2 < kMinGallop) {
+      if (p(*f2, *f1)) {
+        *out = *f2;
+        ++f2;
+        ++wins2;
+        wins1 = 0;
+      } else {
+        *out = *f1;
+        ++f1;
+        ++wins1;
+        wins2 = 0;
+      }
+      ++out;
+      if (f1 == l1 || f2 == l2) return std::make_tuple(f1, f2, out);
+    }
+
+    while (true) {
+      I1 m1 = upper_bound_biased(f1, l1, *f2, p);
+      std::ptrdiff_t copied1 = std::distance(f1, m1);
+      out = std::copy(f1, m1, out);
+      f1 = m1;
+      if (f1 == l1) return std::make_tuple(f1, f2, out);
+
+      I2 m2 = lower_bound_biased(f2, l2, *f1, p);
+      std::ptrdiff_t copied2 = std::distance(f2, m2);
+      out = std::copy(f2, m2, out);
+      f2 = m2;
+      if (f2 == l2) return std::make_tuple(f1, f2, out);
+
+      if (copied1 < kMinGallop && copied2 < kMinGallop) break;
+    }
+  }
+  return std::make_tuple(f1, f2, out);
+}
+
+template <typename I1, typename I2, typename O, typename P>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          StrictWeakOrder<P(ValueType<I1>, ValueType<I2>)>
+O merge_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out, P p) {
+  std::tie(f1, f2, out) =
+      merge_biased_until_one_is_empty(f1, l1, f2, l2, out, p);
+  return std::copy(f2, l2, std::copy(f1, l1, out));
+}
+
+template <typename I1, typename I2, typename O>
+// requires ForwardIterator<I1> && ForwardIterator<I2> &&
+//          OutputIterator<O, ValueType<I1>> &&
+//          WeakComarable<ValueType<I1>, ValueType<I2>>
+O merge_biased(I1 f1, I1 l1, I2 f2, I2 l2, O out) {
+  return merge_biased(f1, l1, f2, l2, out, less{});
+}
+
+template <typename I, typename P>
+// requires BidirectionalIterator<I> && StrictWeakOrder<P(ValueType<I>)>
+void inplace_merge_biased(I f, I m, I l, P p) {
+  if (f == m || m == l) return;
+
+  // Elements that are already in place.
+  f = upper_bound_biased(f, m, *m, p);
+  if (f == m) return;
+  auto last1 = std::prev(m);
+  l = partition_point_biased(std::reverse_iterator<I>(l),
+                             std::reverse_iterator<I>(m),
+                             [&](Reference<I> x) { return p(*last1, x); })
+          .base();
+
+  // Move the shorter run out and merge from the side where it was, so
+  // that we never overwrite what's not read yet.
+  std::vector<ValueType<I>> buf;
+  if (std::distance(f, m) <= std::distance(m, l)) {
+    buf.assign(std::make_move_iterator(f), std::make_move_iterator(m));
+    auto res = merge_biased_until_one_is_empty(
+        buf.begin(), buf.end(), std::make_move_iterator(m),
+        std::make_move_iterator(l), f, p);
+    std::move(std::get<0>(res), buf.end(), std::get<2>(res));
+    return;
+  }
+
+  using reverse_it = std::reverse_iterator<I>;
+  buf.assign(std::make_move_iterator(m), std::make_move_iterator(l));
+  auto reverse_p = [&](const auto& x, const auto& y) { return p(y, x); };
+  auto res = merge_biased_until_one_is_empty(
+      buf.rbegin(), buf.rend(), std::make_move_iterator(reverse_it(m)),
+      std::make_move_iterator(reverse_it(f)), reverse_it(l), reverse_p);
+  std::move(std::get<0>(res), buf.rend(), std::get<2>(res));
+}
+
+template <typename I>
+// requires BidirectionalIterator<I> && TotallyOrdered<ValueType<I>>
+void inplace_merge_biased(I f, I m, I l) {
+  inplace_merge_biased(f, m, l, less{});
+}
+
+// Natural merge sort: splits the input into sorted runs and merges them
+// with merge_biased, so k presorted runs cost O(n log k).
+// Stable.
+
+constexpr std::ptrdiff_t kMinRun = 32;
+
+template <typename I, typename P>
+// requires RandomAccessIterator<I> && StrictWeakOrder<P(ValueType<I>)>
+I natural_run_end(I f, I l, P p) {
+  I run_l = std::next(f);
+  if (run_l == l) return l;
+
+  // Only strictly descending runs can be reversed without breaking
+  // stability.
+  if (p(*run_l, *f)) {
+    do {
+      ++run_l;
+    } while (run_l != l && p(*run_l, *std::prev(run_l)));
+    std::reverse(f, run_l);
+  } else {
+    do {
+      ++run_l;
+    } while (run_l != l && !p(*run_l, *std::prev(run_l)));
+  }
+
+  // Short runs are extended with binary insertion.
+  I min_run_l = f + std::min(kMinRun, l - f);
+  for (; run_l < min_run_l; ++run_l)
+    std::rotate(upper_bound_biased(f, run_l, *run_l, p), run_l,
+                std::next(run_l));
+  return run_l;
+}
+
+template <typename I, typename O, typename P>
+// requires RandomAccessIterator<I> && RandomAccessIterator<O> &&
+//          StrictWeakOrder<P(ValueType<I>)>
+void merge_adjacent_runs(I f, const std::vector<std::ptrdiff_t>& runs, O out,
+                         std::vector<std::ptrdiff_t>& merged_runs, P p) {
+  merged_runs.clear();
+  merged_runs.push_back(0);
+
+  std::size_t i = 0;
+  for (; i + 2 < runs.size(); i += 2) {
+    merge_biased(std::make_move_iterator(f + runs[i]),
+                 std::make_move_iterator(f + runs[i + 1]),
+                 std::make_move_iterator(f + runs[i + 1]),
+                 std::make_move_iterator(f + runs[i + 2]), out + runs[i], p);
+    merged_runs.push_back(runs[i + 2]);
+  }
+
+  if (i + 1 < runs.size()) {
+    std::move(f + runs[i], f + runs[i + 1], out + runs[i]);
+    merged_runs.push_back(runs[i + 1]);
+  }
+}
+
+template <typename I, typename P>
+// requires RandomAccessIterator<I> && StrictWeakOrder<P(ValueType<I>)>
+void sort_adaptive(I f, I l, P p) {
+  // Offsets of runs' boundaries.
+  std::vector<std::ptrdiff_t> runs{0};
+  for (I run_f = f; run_f != l;) {
+    run_f = natural_run_end(run_f, l, p);
+    runs.push_back(run_f - f);
+  }
+  if (runs.size() <= 2) return;
+
+  // Merges pairs of runs back and forth between the input and a buffer.
+  std::vector<ValueType<I>> buf(std::make_move_iterator(f),
+                                std::make_move_iterator(l));
+  std::vector<std::ptrdiff_t> merged_runs;
+  bool in_buf = true;
+  while (runs.size() > 2) {
+    if (in_buf)
+      merge_adjacent_runs(buf.begin(), runs, f, merged_runs, p);
+    else
+      merge_adjacent_runs(f, runs, buf.begin(), merged_runs, p);
+    in_buf = !in_buf;
+    runs.swap(merged_runs);
+  }
+
+  if (in_buf) std::move(buf.begin(), buf.end(), f);
+}
+
+template <typename I>
+// requires RandomAccessIterator<I> && TotallyOrdered<ValueType<I>>
+void sort_adaptive(I f, I l) {
+  sort_adaptive(f, l, less{});
+}
+
+// unique for sorted ranges: jumps over each run of equivalent elements
+// with upper_bound_biased, so long runs cost O(log(run)) comparisons.
+// The first element of every run is kept.
+
+template <typename I, typename P>
+// requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>)>
+I end_of_equal_run(I f, I l, P p) {
+  I next = std::next(f);
+  // Most runs are short, check the next element before galloping.
+  if (next == l || p(*f, *next)) return next;
+  return upper_bound_biased(std::next(next), l, *f, p);
+}
+
+template <typename I, typename P>
+// requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>)>
+I unique_biased(I f, I l, P p) {
+  // Nothing to move until the first duplicate.
+  while (f != l) {
+    I next = end_of_equal_run(f, l, p);
+    if (next != std::next(f)) break;
+    f = next;
+  }
+  if (f == l) return l;
+
+  I out = f;
+  while (f != l) {
+    I next = end_of_equal_run(f, l, p);
+    if (out != f) *out = std::move(*f);
+    ++out;
+    f = next;
+  }
+  return out;
+}
+
+template <typename I>
+// requires ForwardIterator<I> && TotallyOrdered<ValueType<I>>
+I unique_biased(I f, I l) {
+  return unique_biased(f, l, less{});
+}
+
+template <typename I, typename O, typename P>
+// requires ForwardIterator<I> && OutputIterator<O, ValueType<I>> &&
+//          StrictWeakOrder<P(ValueType<I>)>
+O unique_copy_biased(I f, I l, O out, P p) {
+  while (f != l) {
+    *out = *f;
+    ++out;
+    f = end_of_equal_run(f, l, p);
+  }
+  return out;
+}
+
+template <typename I, typename O>
+// requires ForwardIterator<I> && OutputIterator<O, ValueType<I>> &&
+//          TotallyOrdered<ValueType<I>>
+O unique_copy_biased(I f, I l, O out) {
+  return unique_copy_biased(f, l, out, less{});
+}
+
+template <typename I, typename P>
+// requires RandomAccessIterator<I> && Predicate<P(ValueType<I>)>
+I partition_point_n_branchless(I f, DifferenceType<I> n, P p) {
+  if (n == 0) return f;
+  while (n > 1) {
+    DifferenceType<I> n2 = n / 2;
+    f += p(f[n2]) ? n2 : 0;  // compiles to cmov, no branch on the result.
+    n -= n2;
+  }
+  return f + static_cast<DifferenceType<I>>(p(*f));
+}
+
+template <typename I, typename P>
+I partition_point_biased_branchless(I f, I l, P p, std::forward_iterator_tag) {
+  return partition_point_biased(f, l, p);
+}
+
+template <typename I, typename P>
+// requires RandomAccessIterator<I> && Predicate<P(ValueType<I>)>
+I partition_point_biased_branchless(I f, I l, P p,
+                                    std::random_access_iterator_tag) {
+  // Galloping only mispredicts once - when it stops.
+  DifferenceType<I> n = l - f;
+  for (DifferenceType<I> step = 1; step <= n; step += step) {
+    if (!p(f[step - 1])) return partition_point_n_branchless(f, step - 1, p);
+    f += step;
+    n -= step;
+  }
+  return partition_point_n_branchless(f, n, p);
+}
+
+template <typename I, typename P>
+// requires ForwardIterator<I> && Predicate<P(ValueType<I>)>
+I partition_point_biased_branchless(I f, I l, P p) {
+  return partition_point_biased_branchless(f, l, p, IteratorCategory<I>{});
+}
+
+template <typename I, typename V, typename P>
+// requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>, V)>
+I lower_bound_biased_branchless(I f, I l, const V& v, P p) {
+  return partition_point_biased_branchless(
+      f, l, [&](Reference<I> x) { return p(x, v); });
+}
+
+template <typename I, typename V>
+// requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
+I lower_bound_biased_branchless(I f, I l, const V& v) {
+  return lower_bound_biased_branchless(f, l, v, less{});
+}
+
+template <typename I, typename V, typename P>
+// requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>, V)>
+I upper_bound_biased_branchless(I f, I l, const V& v, P p) {
+  return partition_point_biased_branchless(
+      f, l, [&](Reference<I> x) { return !p(v, x); });
+}
+
+template <typename I, typename V>
+// requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
+I upper_bound_biased_branchless(I f, I l, const V& v) {
+  return upper_bound_biased_branchless(f, l, v, less{});
+}
+
+template <typename I, typename V, typename P>
+// requires ForwardIterator<I> && StrictWeakOrder<P(ValueType<I>, V)>
+std::pair<I, I> equal_range_biased_branchless(I f, I l, const V& v, P p) {
+  auto lb = lower_bound_biased_branchless(f, l, v, p);
+  auto ub = upper_bound_biased_branchless(lb, l, v, p);
+  return {lb, ub};
+}
+
+template <typename I, typename V>
+// requires ForwardIterator<I> && WeakComarable<ValueType<I>, V>
+std::pair<I, I> equal_range_biased_branchless(I f, I l, const V& v) {
+  return equal_range_biased_branchless(f, l, v, less{});
 }
 
 template <typename I, typename P>
@@ -308,7 +1267,160 @@ std::pair<I, I> equal_range_hinted(I f, I h, I l, const V& v, P p) {
 template <typename I, typename V>
 // requires BidirectionalIterator<I> && WeakComarable<ValueType<I>, V>
 std::pair<I, I> equal_range_hinted(I f, I h, I l, const V& v) {
-  return equal_range_hinted(f, h, l, v, less{});
+  return equal_range_hinted(f, h, l, v, default_compare<ValueType<I>, V>{});
+}
+
+// Three-way versions of the equal_range functions: see
+// three_way_compare.
+
+template <typename I, typename V, typename C>
+// requires ForwardIterator<I> && ThreeWayCompare<C(ValueType<I>, V)>
+std::pair<I, I> equal_range_n(I f, DifferenceType<I> n, const V& v,
+                              three_way_compare<C> c) {
+  while (n != 0) {
+    DifferenceType<I> n2 = n / 2;
+    I m = std::next(f, n2);
+    int r = c.compare(*m, v);
+    if (r < 0) {
+      f = ++m;
+      n -= n2 + 1;
+    } else if (r > 0) {
+      n = n2;
+    } else {
+      return {
+          partition_point_n(f, n2,
+                            [&](Reference<I> x) { return c.compare(x, v) < 0; }),
+          partition_point_n(std::next(m), n - n2 - 1,
+                            [&](Reference<I> x) { return c.compare(x, v) == 0; }),
+      };
+    }
+  }
+  return {f, f};
+}
+
+// Gallops until an element that is not less than v: if it is greater,
+// the answer is in the last window; if it is equal, only the lower
+// bound is, and the upper one is searched for from it.
+template <typename I, typename V, typename C>
+// requires ForwardIterator<I> && ThreeWayCompare<C(ValueType<I>, V)>
+std::pair<I, I> equal_range_biased(I f, I l, const V& v,
+                                   three_way_compare<C> c) {
+  for (DifferenceType<I> step = 1;; step += step) {
+    I probe = f;
+    DifferenceType<I> left = step - 1;
+    advance_checked(probe, l, left);
+    DifferenceType<I> window = step - 1 - left;
+    if (probe == l) return equal_range_n(f, window, v, c);
+
+    int r = c.compare(*probe, v);
+    if (r < 0) {
+      f = ++probe;
+    } else if (r > 0) {
+      return equal_range_n(f, window, v, c);
+    } else {
+      return {
+          partition_point_n(f, window,
+                            [&](Reference<I> x) { return c.compare(x, v) < 0; }),
+          partition_point_biased(
+              ++probe, l, [&](Reference<I> x) { return c.compare(x, v) == 0; }),
+      };
+    }
+  }
+}
+
+template <typename I, typename V, typename C>
+// requires BidirectionalIterator<I> && ThreeWayCompare<C(ValueType<I>, V)>
+std::pair<I, I> equal_range_hinted(I f, I h, I l, const V& v,
+                                   three_way_compare<C> c) {
+  using R = std::reverse_iterator<I>;
+
+  int r = h == l ? 1 : c.compare(*h, v);
+  if (r < 0) return equal_range_biased(std::next(h), l, v, c);
+  if (r > 0) {
+    // [f, h) backwards is sorted by the opposite comparison.
+    auto rc = three_way([&](const ValueType<I>& x, const V& y) {
+      return -c.compare(x, y);
+    });
+    auto res = equal_range_biased(R(h), R(f), v, rc);
+    return {res.second.base(), res.first.base()};
+  }
+  return {
+      partition_point_biased(R(h), R(f),
+                             [&](Reference<I> x) { return c.compare(x, v) == 0; })
+          .base(),
+      partition_point_biased(std::next(h), l,
+                             [&](Reference<I> x) { return c.compare(x, v) == 0; }),
+  };
+}
+
+// Interpolation search guesses where v is from the values at the ends of
+// the range, which takes O(log log n) probes on uniform keys and O(n) on
+// skewed ones. Here we only do two interpolation probes and then gallop
+// from the guess, so a bad guess costs O(log distance) to fix.
+
+template <typename I, typename V>
+// requires RandomAccessIterator<I> && Arithmetic<ValueType<I>> &&
+//          Arithmetic<V>
+DifferenceType<I> interpolate(I f, DifferenceType<I> lo, DifferenceType<I> hi,
+                              const V& v) {
+  double a = static_cast<double>(f[lo]);
+  double b = static_cast<double>(f[hi]);
+  double ratio = (static_cast<double>(v) - a) / (b - a);
+  // Also catches NaN from inf / inf and 0 / 0.
+  if (!(ratio >= 0)) ratio = 0;
+  if (!(ratio <= 1)) ratio = 1;
+  return lo + static_cast<DifferenceType<I>>(ratio *
+                                             static_cast<double>(hi - lo));
+}
+
+template <typename I, typename V, typename P>
+// requires RandomAccessIterator<I> && Arithmetic<ValueType<I>> &&
+//          Arithmetic<V> && Predicate<P(ValueType<I>)>
+//          v is where the partition point of p is in the ascending order.
+I partition_point_interpolated_biased(I f, I l, const V& v, P p) {
+  if (f == l || !p(*f)) return f;
+  if (p(*(l - 1))) return l;
+
+  // The answer is in (lo, hi].
+  DifferenceType<I> lo = 0;
+  DifferenceType<I> hi = (l - f) - 1;
+
+  DifferenceType<I> guess = interpolate(f, lo, hi, v);
+  if (guess != lo && guess != hi) {
+    if (p(f[guess]))
+      lo = guess;
+    else
+      hi = guess;
+    guess = interpolate(f, lo, hi, v);
+  }
+  guess = std::max(guess, lo + 1);
+
+  return partition_point_hinted(f + lo + 1, f + guess, f + hi, p);
+}
+
+template <typename I, typename V>
+// requires RandomAccessIterator<I> && Arithmetic<ValueType<I>> &&
+//          Arithmetic<V>
+I lower_bound_interpolated_biased(I f, I l, const V& v) {
+  return partition_point_interpolated_biased(
+      f, l, v, [&](Reference<I> x) { return x < v; });
+}
+
+template <typename I, typename V>
+// requires RandomAccessIterator<I> && Arithmetic<ValueType<I>> &&
+//          Arithmetic<V>
+I upper_bound_interpolated_biased(I f, I l, const V& v) {
+  return partition_point_interpolated_biased(
+      f, l, v, [&](Reference<I> x) { return !(v < x); });
+}
+
+template <typename I, typename V>
+// requires RandomAccessIterator<I> && Arithmetic<ValueType<I>> &&
+//          Arithmetic<V>
+std::pair<I, I> equal_range_interpolated_biased(I f, I l, const V& v) {
+  I lb = lower_bound_interpolated_biased(f, l, v);
+  I ub = upper_bound_biased(lb, l, v);
+  return {lb, ub};
 }
 
 template <typename I>
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <iterator>
+
+#include "result.h"
+
+namespace srt {
+
+// Remembers where the last search ended and starts the next one from
+// there with partition_point_hinted, so a stream of queries close to
+// each other costs O(log distance) per query instead of O(log n).
+// Works in both directions.
+
+template <typename I, typename Compare = less>
+// requires BidirectionalIterator<I> && StrictWeakOrder<Compare(ValueType<I>)>
+class search_cursor : Compare {
+  I f_;
+  I l_;
+  I pos_;
+
+  const Compare& comp() const { return *this; }
+
+ public:
+  search_cursor(I f, I l, Compare comp = Compare{})
+      : Compare(comp), f_(f), l_(l), pos_(f) {}
+
+  I begin() const { return f_; }
+  I end() const { return l_; }
+
+  // Where the next search starts.
+  I position() const { return pos_; }
+  void set_position(I pos) { pos_ = pos; }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(ValueType<I>, V)>
+  I lower_bound(const V& v) {
+    pos_ = lower_bound_hinted(f_, pos_, l_, v, comp());
+    return pos_;
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(ValueType<I>, V)>
+  I upper_bound(const V& v) {
+    pos_ = upper_bound_hinted(f_, pos_, l_, v, comp());
+    return pos_;
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(ValueType<I>, V)>
+  std::pair<I, I> equal_range(const V& v) {
+    auto res = equal_range_hinted(f_, pos_, l_, v, comp());
+    pos_ = res.first;
+    return res;
+  }
+};
+
+template <typename I, typename Compare>
+// requires BidirectionalIterator<I> && StrictWeakOrder<Compare(ValueType<I>)>
+search_cursor<I, Compare> make_search_cursor(I f, I l, Compare comp) {
+  return {f, l, comp};
+}
+
+template <typename I>
+// requires BidirectionalIterator<I> && TotallyOrdered<ValueType<I>>
+search_cursor<I> make_search_cursor(I f, I l) {
+  return {f, l};
+}
+
+}  // namespace srt
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "search_cursor.h"
+
+namespace {
+
+constexpr std::size_t kVectorSize = 1000000u;
+constexpr std::size_t kListSize = 1u << 16;
+constexpr std::size_t kQueriesCount = 1u << 16;
+
+std::vector<std::int64_t> sorted_ints(std::size_t size) {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(0, 9);
+  std::vector<std::int64_t> res(size);
+  for (std::size_t i = 0; i != size; ++i)
+    res[i] = static_cast<std::int64_t>(i) * 10 + dis(g);
+  return res;
+}
+
+// Mostly increasing: every query is up to `max_step` elements after the
+// previous one, or a quarter of that back. 0 means random queries.
+std::vector<std::int64_t> query_stream(const std::vector<std::int64_t>& input,
+                                       std::size_t max_step) {
+  std::mt19937 g;
+  std::vector<std::int64_t> res(kQueriesCount);
+
+  if (max_step == 0) {
+    std::uniform_int_distribution<std::size_t> dis(0, input.size() - 1);
+    for (auto& x : res) x = input[dis(g)];
+    return res;
+  }
+
+  auto step = static_cast<std::ptrdiff_t>(max_step);
+  std::uniform_int_distribution<std::ptrdiff_t> dis(-step / 4, step);
+  std::ptrdiff_t idx = 0;
+  auto size = static_cast<std::ptrdiff_t>(input.size());
+  for (auto& x : res) {
+    idx = (idx + dis(g) + size) % size;
+    x = input[static_cast<std::size_t>(idx)];
+  }
+  return res;
+}
+
+void set_max_step(benchmark::internal::Benchmark* bench) {
+  for (int step : {1, 16, 256, 4096, 65536}) bench->Arg(step);
+  bench->Arg(0);
+}
+
+struct std_search {
+  template <typename I>
+  struct searcher {
+    I f;
+    I l;
+
+    template <typename V>
+    I operator()(const V& v) {
+      return std::lower_bound(f, l, v);
+    }
+  };
+
+  template <typename I>
+  searcher<I> operator()(I f, I l) {
+    return {f, l};
+  }
+};
+
+struct cursor {
+  template <typename I>
+  struct searcher {
+    srt::search_cursor<I> c;
+
+    template <typename V>
+    I operator()(const V& v) {
+      return c.lower_bound(v);
+    }
+  };
+
+  template <typename I>
+  searcher<I> operator()(I f, I l) {
+    return {srt::make_search_cursor(f, l)};
+  }
+};
+
+template <typename Searcher, typename C>
+void run_queries(benchmark::State& state, const C& c,
+                 const std::vector<std::int64_t>& queries) {
+  auto searcher = Searcher{}(c.begin(), c.end());
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(searcher(queries[i]));
+    i = (i + 1) % queries.size();
+  }
+}
+
+}  // namespace
+
+template <typename Searcher>
+void benchmark_locality_vector(benchmark::State& state) {
+  const auto input = sorted_ints(kVectorSize);
+  const auto queries =
+      query_stream(input, static_cast<std::size_t>(state.range(0)));
+  run_queries<Searcher>(state, input, queries);
+}
+
+template <typename Searcher>
+void benchmark_locality_list(benchmark::State& state) {
+  const auto input = sorted_ints(kListSize);
+  const auto queries =
+      query_stream(input, static_cast<std::size_t>(state.range(0)));
+  const std::list<std::int64_t> as_list(input.begin(), input.end());
+  run_queries<Searcher>(state, as_list, queries);
+}
+
+BENCHMARK_TEMPLATE(benchmark_locality_vector, std_search)->Apply(set_max_step);
+BENCHMARK_TEMPLATE(benchmark_locality_vector, cursor)->Apply(set_max_step);
+BENCHMARK_TEMPLATE(benchmark_locality_list, std_search)->Apply(set_max_step);
+BENCHMARK_TEMPLATE(benchmark_locality_list, cursor)->Apply(set_max_step);
@@ -0,0 +1,56 @@
+#include "search_cursor.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename C>
+void test_search_cursor(const C& c, int max_value) {
+  std::mt19937 g;
+
+  for (int max_step : {1, 3, 20, max_value}) {
+    std::uniform_int_distribution<int> step(-max_step / 4, max_step);
+    auto cursor = srt::make_search_cursor(c.begin(), c.end());
+
+    int v = -1;
+    for (int i = 0; i < 300; ++i) {
+      v = std::min(std::max(v + step(g), -1), max_value + 1);
+
+      REQUIRE(cursor.lower_bound(v) == std::lower_bound(c.begin(), c.end(), v));
+      REQUIRE(cursor.position() == std::lower_bound(c.begin(), c.end(), v));
+      REQUIRE(cursor.upper_bound(v) == std::upper_bound(c.begin(), c.end(), v));
+      REQUIRE(cursor.equal_range(v) == std::equal_range(c.begin(), c.end(), v));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("search_cursor", "[search_cursor]") {
+  std::mt19937 g;
+
+  for (int size : {0, 1, 2, 10, 100, 1000}) {
+    std::uniform_int_distribution<int> dis(0, size);
+    std::vector<int> v(static_cast<std::size_t>(size));
+    for (int& x : v) x = dis(g);
+    std::sort(v.begin(), v.end());
+
+    test_search_cursor(v, size);
+    test_search_cursor(std::list<int>(v.begin(), v.end()), size);
+  }
+}
+
+TEST_CASE("search_cursor_custom_compare", "[search_cursor]") {
+  std::vector<int> v{9, 7, 7, 5, 3, 1};
+  auto cursor = srt::make_search_cursor(v.begin(), v.end(), std::greater<>{});
+
+  REQUIRE(cursor.lower_bound(7) == v.begin() + 1);
+  REQUIRE(cursor.upper_bound(7) == v.begin() + 3);
+  REQUIRE(cursor.lower_bound(0) == v.end());
+  REQUIRE(cursor.lower_bound(10) == v.begin());
+}
@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "result.h"
+
+namespace {
+
+constexpr std::size_t kBigSize = 1000000u;
+
+struct posting_lists {
+  std::vector<std::int64_t> big;
+  std::vector<std::int64_t> small;  // half of it is in big.
+  std::vector<std::int64_t> small_subset;  // no duplicates, all in big.
+};
+
+const posting_lists& lists_for_ratio(std::size_t ratio) {
+  static posting_lists res;
+  static std::size_t res_ratio = 0;
+  if (res_ratio == ratio) return res;
+
+  std::mt19937 g;
+  res.big.clear();
+  for (std::size_t i = 0; i != kBigSize; ++i)
+    res.big.push_back(static_cast<std::int64_t>(i) * 2);
+
+  std::size_t small_size = std::max<std::size_t>(kBigSize / ratio, 1);
+  std::uniform_int_distribution<std::size_t> dis(0, kBigSize - 1);
+  res.small.clear();
+  res.small_subset.clear();
+  for (std::size_t i = 0; i != small_size; ++i) {
+    std::int64_t x = res.big[dis(g)];
+    res.small_subset.push_back(x);
+    res.small.push_back(x + static_cast<std::int64_t>(i % 2));
+  }
+  std::sort(res.small.begin(), res.small.end());
+  std::sort(res.small_subset.begin(), res.small_subset.end());
+  res.small_subset.erase(
+      std::unique(res.small_subset.begin(), res.small_subset.end()),
+      res.small_subset.end());
+
+  res_ratio = ratio;
+  return res;
+}
+
+void set_size_ratio(benchmark::internal::Benchmark* bench) {
+  for (std::size_t ratio = 1; ratio <= 10000; ratio *= 10)
+    bench->Arg(static_cast<int>(ratio));
+}
+
+struct std_intersection {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return std::set_intersection(f1, l1, f2, l2, out);
+  }
+};
+
+struct biased_intersection {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return srt::set_intersection_biased(f1, l1, f2, l2, out);
+  }
+};
+
+struct std_difference {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return std::set_difference(f1, l1, f2, l2, out);
+  }
+};
+
+struct biased_difference {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return srt::set_difference_biased(f1, l1, f2, l2, out);
+  }
+};
+
+struct std_union {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return std::set_union(f1, l1, f2, l2, out);
+  }
+};
+
+struct biased_union {
+  template <typename I, typename O>
+  O operator()(I f1, I l1, I f2, I l2, O out) {
+    return srt::set_union_biased(f1, l1, f2, l2, out);
+  }
+};
+
+struct std_includes {
+  template <typename I>
+  bool operator()(I f1, I l1, I f2, I l2) {
+    return std::includes(f1, l1, f2, l2);
+  }
+};
+
+struct biased_includes {
+  template <typename I>
+  bool operator()(I f1, I l1, I f2, I l2) {
+    return srt::includes_biased(f1, l1, f2, l2);
+  }
+};
+
+}  // namespace
+
+// Small list first for the difference: that's the case where
+// std::set_difference has to walk the big one.
+template <typename Alg>
+void benchmark_set_algorithm(benchmark::State& state) {
+  const auto& lists = lists_for_ratio(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::int64_t> out(lists.big.size() + lists.small.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Alg{}(lists.small.begin(), lists.small.end(),
+                                   lists.big.begin(), lists.big.end(),
+                                   out.begin()));
+    benchmark::ClobberMemory();
+  }
+}
+
+template <typename Alg>
+void benchmark_includes(benchmark::State& state) {
+  const auto& lists = lists_for_ratio(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Alg{}(lists.big.begin(), lists.big.end(),
+                                   lists.small_subset.begin(),
+                                   lists.small_subset.end()));
+  }
+}
+
+BENCHMARK_TEMPLATE(benchmark_set_algorithm, std_intersection)->Apply(set_size_ratio);
+BENCHMARK_TEMPLATE(benchmark_set_algorithm, biased_intersection)->Apply(set_size_ratio);
+BENCHMARK_TEMPLATE(benchmark_set_algorithm, std_difference)->Apply(set_size_ratio);
+BENCHMARK_TEMPLATE(benchmark_set_algorithm, biased_difference)->Apply(set_size_ratio);
+BENCHMARK_TEMPLATE(benchmark_set_algorithm, std_union)->Apply(set_size_ratio);
+BENCHMARK_TEMPLATE(benchmark_set_algorithm, biased_union)->Apply(set_size_ratio);
+BENCHMARK_TEMPLATE(benchmark_includes, std_includes)->Apply(set_size_ratio);
+BENCHMARK_TEMPLATE(benchmark_includes, biased_includes)->Apply(set_size_ratio);
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "result.h"
+
+namespace srt {
+
+// Sorted multiset as a skip list. Node heights are geometric with p = 1/2,
+// so the first node of height > i is expected around position 2^i.
+//
+// Searches follow the partition_point_biased contract: to find the
+// partition point of p, we first climb the head's links while the first
+// node on the next level still satisfies p (galloping), and only then go
+// down the usual way. An answer at distance d costs O(log d) expected,
+// O(1) next to the front.
+//
+// Every level is a circular list through the head, level 0 is also
+// linked backwards, so the iterators are bidirectional and work with
+// group_equals and the *_hinted functions.
+
+template <typename T, typename Compare = less>
+class skip_list : Compare {
+  static constexpr std::size_t kMaxHeight = 32;
+
+  struct node_base {
+    node_base* prev;
+    node_base** next;  // [0, height), stored right after the node.
+    std::size_t height;
+  };
+
+  struct node : node_base {
+    T value;
+
+    template <typename... Args>
+    explicit node(Args&&... args) : value(std::forward<Args>(args)...) {}
+  };
+
+  static constexpr std::size_t links_offset(std::size_t size) {
+    return (size + alignof(node_base*) - 1) / alignof(node_base*) *
+           alignof(node_base*);
+  }
+
+  node_base* head_;
+  std::size_t size_ = 0;
+  std::uint64_t random_state_ = 0x9E3779B97F4A7C15u;
+
+  Compare comp() const { return *this; }
+
+  static const T& value(const node_base* n) {
+    return static_cast<const node*>(n)->value;
+  }
+
+  static void init_links(node_base* n, void* mem, std::size_t offset,
+                         std::size_t height) {
+    n->prev = nullptr;
+    n->height = height;
+    n->next = reinterpret_cast<node_base**>(static_cast<char*>(mem) + offset);
+  }
+
+  static node_base* create_head() {
+    constexpr std::size_t offset = links_offset(sizeof(node_base));
+    void* mem = ::operator new(offset + kMaxHeight * sizeof(node_base*));
+    node_base* res = ::new (mem) node_base;
+    init_links(res, mem, offset, kMaxHeight);
+    for (std::size_t i = 0; i != kMaxHeight; ++i) res->next[i] = res;
+    res->prev = res;
+    return res;
+  }
+
+  static void destroy_head(node_base* head) {
+    head->~node_base();
+    ::operator delete(head);
+  }
+
+  template <typename... Args>
+  static node* create_node(std::size_t height, Args&&... args) {
+    constexpr std::size_t offset = links_offset(sizeof(node));
+    void* mem = ::operator new(offset + height * sizeof(node_base*));
+    node* res;
+    try {
+      res = ::new (mem) node(std::forward<Args>(args)...);
+    } catch (...) {
+      ::operator delete(mem);
+      throw;
+    }
+    init_links(res, mem, offset, height);
+    return res;
+  }
+
+  static void destroy_node(node_base* n) {
+    node* x = static_cast<node*>(n);
+    x->~node();
+    ::operator delete(static_cast<void*>(x));
+  }
+
+  std::size_t random_height() {
+    // xorshift64
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 7;
+    random_state_ ^= random_state_ << 17;
+    std::uint64_t bits =
+        random_state_ | (std::uint64_t{1} << (kMaxHeight - 1));
+    return 1 + static_cast<std::size_t>(__builtin_ctzll(bits));
+  }
+
+  // Returns the last node that satisfies p (or the head). Fills
+  // update[i] with the last such node on level i, for i < height.
+  template <typename P>
+  node_base* search(P p, node_base** update, std::size_t height) const {
+    std::size_t level = 0;
+    while (level + 1 != kMaxHeight && head_->next[level + 1] != head_ &&
+           p(value(head_->next[level + 1])))
+      ++level;
+
+    // On the levels above, the first node already doesn't satisfy p.
+    for (std::size_t i = level + 1; i < height; ++i) update[i] = head_;
+
+    node_base* x = head_;
+    for (std::size_t i = level + 1; i-- != 0;) {
+      while (x->next[i] != head_ && p(value(x->next[i]))) x = x->next[i];
+      if (i < height) update[i] = x;
+    }
+    return x;
+  }
+
+  // Links n after update[i] on every level of n.
+  void link(node_base* n, node_base** update) {
+    for (std::size_t i = 0; i != n->height; ++i) {
+      n->next[i] = update[i]->next[i];
+      update[i]->next[i] = n;
+    }
+    n->prev = update[0];
+    n->next[0]->prev = n;
+    ++size_;
+  }
+
+  void append_all(const skip_list& x) {
+    node_base* last[kMaxHeight];
+    for (auto& l : last) l = head_;
+
+    for (const T& v : x) {
+      node* n = create_node(random_height(), v);
+      link(n, last);
+      for (std::size_t i = 0; i != n->height; ++i) last[i] = n;
+    }
+  }
+
+ public:
+  class iterator {
+    friend class skip_list;
+    node_base* n_ = nullptr;
+
+    explicit iterator(node_base* n) : n_(n) {}
+
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = const T*;
+    using reference = const T&;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    iterator() = default;
+
+    reference operator*() const { return value(n_); }
+    pointer operator->() const { return &value(n_); }
+
+    iterator& operator++() {
+      n_ = n_->next[0];
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    iterator& operator--() {
+      n_ = n_->prev;
+      return *this;
+    }
+
+    iterator operator--(int) {
+      auto tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    friend bool operator==(const iterator& x, const iterator& y) {
+      return x.n_ == y.n_;
+    }
+
+    friend bool operator!=(const iterator& x, const iterator& y) {
+      return !(x == y);
+    }
+  };
+
+  using value_type = T;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+
+  skip_list() : skip_list(Compare{}) {}
+  explicit skip_list(Compare comp) : Compare(comp), head_(create_head()) {}
+
+  template <typename I>
+  // requires InputIterator<I> && ValueType<I> == T
+  skip_list(I f, I l, Compare comp = Compare{}) : skip_list(comp) {
+    // The delegated constructor is done, so the destructor cleans up if
+    // this throws.
+    for (; f != l; ++f) insert(*f);
+  }
+
+  skip_list(const skip_list& x) : skip_list(x.comp()) { append_all(x); }
+
+  skip_list(skip_list&& x) : skip_list(x.comp()) { swap(x); }
+
+  skip_list& operator=(skip_list x) {
+    swap(x);
+    return *this;
+  }
+
+  ~skip_list() {
+    clear();
+    destroy_head(head_);
+  }
+
+  void swap(skip_list& x) {
+    using std::swap;
+    swap(static_cast<Compare&>(*this), static_cast<Compare&>(x));
+    swap(head_, x.head_);
+    swap(size_, x.size_);
+    swap(random_state_, x.random_state_);
+  }
+
+  iterator begin() const { return iterator(head_->next[0]); }
+  iterator end() const { return iterator(head_); }
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    node_base* x = head_->next[0];
+    while (x != head_) {
+      node_base* next = x->next[0];
+      destroy_node(x);
+      x = next;
+    }
+    for (std::size_t i = 0; i != kMaxHeight; ++i) head_->next[i] = head_;
+    head_->prev = head_;
+    size_ = 0;
+  }
+
+  template <typename P>
+  // requires Predicate<P(T)>
+  iterator partition_point(P p) const {
+    return iterator(search(p, nullptr, 0)->next[0]);
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  iterator lower_bound(const V& v) const {
+    return partition_point([&](const T& x) { return comp()(x, v); });
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  iterator upper_bound(const V& v) const {
+    return partition_point([&](const T& x) { return !comp()(v, x); });
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  range_pair<iterator> equal_range(const V& v) const {
+    iterator lb = lower_bound(v);
+    return {lb, upper_bound_biased(lb, end(), v, comp())};
+  }
+
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  bool contains(const V& v) const {
+    iterator it = lower_bound(v);
+    return it != end() && !comp()(v, *it);
+  }
+
+  // Goes after the elements equivalent to the new one.
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    node* n = create_node(random_height(), std::forward<Args>(args)...);
+    node_base* update[kMaxHeight];
+    search([&](const T& x) { return !comp()(n->value, x); }, update,
+           n->height);
+    link(n, update);
+    return iterator(n);
+  }
+
+  iterator insert(const T& v) { return emplace(v); }
+  iterator insert(T&& v) { return emplace(std::move(v)); }
+
+  iterator erase(iterator pos) {
+    node_base* target = pos.n_;
+    node_base* update[kMaxHeight];
+    search([&](const T& x) { return comp()(x, value(target)); }, update,
+           target->height);
+
+    // update[i] is before the first equivalent element, target can be
+    // any of them.
+    for (std::size_t i = 0; i != target->height; ++i) {
+      while (update[i]->next[i] != target) update[i] = update[i]->next[i];
+      update[i]->next[i] = target->next[i];
+    }
+    target->next[0]->prev = target->prev;
+
+    iterator res(target->next[0]);
+    destroy_node(target);
+    --size_;
+    return res;
+  }
+
+  // Erases all elements equivalent to v, returns how many.
+  template <typename V>
+  // requires StrictWeakOrder<Compare(T, V)>
+  std::size_t erase(const V& v) {
+    auto r = equal_range(v);
+    std::size_t res = 0;
+    for (iterator it = r.begin(); it != r.end(); ++res) it = erase(it);
+    return res;
+  }
+};
+
+}  // namespace srt
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <list>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "skip_list.h"
+
+namespace {
+
+constexpr std::size_t kInitialSize = 10000u;
+constexpr std::size_t kOpsCount = 1u << 14;
+constexpr std::int64_t kMaxValue = static_cast<std::int64_t>(kInitialSize) * 10;
+
+enum locality : int {
+  kUniform = 0,
+  kFront = 1  // all operations touch the first ~1% of the elements
+};
+
+struct op {
+  bool insert;  // insert v and erase the first element >= w, or search v
+  std::int64_t v;
+  std::int64_t w;
+};
+
+std::vector<op> op_stream(int insert_percent, int where) {
+  std::mt19937 g;
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<std::int64_t> values(
+      0, where == kFront ? kMaxValue / 100 : kMaxValue);
+
+  std::vector<op> res(kOpsCount);
+  for (auto& o : res) o = {percent(g) < insert_percent, values(g), values(g)};
+  return res;
+}
+
+std::vector<std::int64_t> initial_values() {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> values(0, kMaxValue);
+  std::vector<std::int64_t> res(kInitialSize);
+  for (auto& x : res) x = values(g);
+  return res;
+}
+
+void set_mix(benchmark::internal::Benchmark* bench) {
+  for (int where : {kUniform, kFront})
+    for (int insert_percent : {10, 50, 90})
+      bench->Args({insert_percent, where});
+}
+
+struct std_multiset {
+  std::multiset<std::int64_t> c;
+
+  template <typename I>
+  std_multiset(I f, I l) : c(f, l) {}
+
+  void insert(std::int64_t v) { c.insert(v); }
+  void erase_lower_bound(std::int64_t v) {
+    auto it = c.lower_bound(v);
+    if (it != c.end()) c.erase(it);
+  }
+  auto search(std::int64_t v) { return c.lower_bound(v); }
+};
+
+struct list_biased {
+  std::list<std::int64_t> c;
+
+  template <typename I>
+  list_biased(I f, I l) : c(f, l) {
+    c.sort();
+  }
+
+  auto search(std::int64_t v) {
+    return srt::lower_bound_biased(c.begin(), c.end(), v);
+  }
+  void insert(std::int64_t v) { c.insert(search(v), v); }
+  void erase_lower_bound(std::int64_t v) {
+    auto it = search(v);
+    if (it != c.end()) c.erase(it);
+  }
+};
+
+struct skip_list {
+  srt::skip_list<std::int64_t> c;
+
+  template <typename I>
+  skip_list(I f, I l) : c(f, l) {}
+
+  void insert(std::int64_t v) { c.insert(v); }
+  void erase_lower_bound(std::int64_t v) {
+    auto it = c.lower_bound(v);
+    if (it != c.end()) c.erase(it);
+  }
+  auto search(std::int64_t v) { return c.lower_bound(v); }
+};
+
+}  // namespace
+
+template <typename Container>
+void benchmark_mixed_ops(benchmark::State& state) {
+  const auto init = initial_values();
+  Container c(init.begin(), init.end());
+  const auto ops = op_stream(static_cast<int>(state.range(0)),
+                             static_cast<int>(state.range(1)));
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const op& o = ops[i];
+    if (o.insert) {
+      c.insert(o.v);
+      c.erase_lower_bound(o.w);
+    } else {
+      benchmark::DoNotOptimize(c.search(o.v));
+    }
+    i = (i + 1) % ops.size();
+  }
+}
+
+BENCHMARK_TEMPLATE(benchmark_mixed_ops, std_multiset)->Apply(set_mix);
+BENCHMARK_TEMPLATE(benchmark_mixed_ops, list_biased)->Apply(set_mix);
+BENCHMARK_TEMPLATE(benchmark_mixed_ops, skip_list)->Apply(set_mix);
@@ -0,0 +1,98 @@
+#include "skip_list.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+TEST_CASE("skip_list", "[skip_list]") {
+  std::mt19937 g;
+
+  for (int max_value : {3, 100, 10000}) {
+    std::uniform_int_distribution<int> dis(0, max_value);
+    srt::skip_list<int> actual;
+    std::multiset<int> expected;
+
+    for (int i = 0; i < 2000; ++i) {
+      int v = dis(g);
+      if (i % 3 == 2) {
+        REQUIRE(actual.erase(v) == expected.erase(v));
+      } else if (i % 7 == 6 && !expected.empty()) {
+        auto it = actual.lower_bound(v);
+        if (it != actual.end()) {
+          auto next = actual.erase(it);
+          auto expected_it = expected.erase(expected.lower_bound(v));
+          REQUIRE((next == actual.end()) == (expected_it == expected.end()));
+        }
+      } else {
+        REQUIRE(*actual.insert(v) == v);
+        expected.insert(v);
+      }
+
+      REQUIRE(actual.size() == expected.size());
+      REQUIRE(std::equal(actual.begin(), actual.end(), expected.begin(),
+                         expected.end()));
+      REQUIRE(std::equal(actual.rbegin(), actual.rend(), expected.rbegin(),
+                         expected.rend()));
+
+      for (int x : {v - 1, v, v + 1}) {
+        REQUIRE(std::distance(actual.begin(), actual.lower_bound(x)) ==
+                std::distance(expected.begin(), expected.lower_bound(x)));
+        REQUIRE(std::distance(actual.begin(), actual.upper_bound(x)) ==
+                std::distance(expected.begin(), expected.upper_bound(x)));
+        REQUIRE(actual.contains(x) == (expected.count(x) != 0));
+      }
+    }
+  }
+}
+
+TEST_CASE("skip_list_with_generic_algorithms", "[skip_list]") {
+  std::vector<int> input;
+  for (int i = 0; i < 20; ++i)
+    for (int j = 0; j < i % 4; ++j) input.push_back(i);
+  std::vector<int> shuffled = input;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{});
+
+  srt::skip_list<int> s(shuffled.begin(), shuffled.end());
+  REQUIRE(std::vector<int>(s.begin(), s.end()) == input);
+
+  std::vector<int> group_sizes;
+  for (auto r : srt::group_equals(s.begin(), s.end(), srt::less{}))
+    group_sizes.push_back(static_cast<int>(std::distance(r.begin(), r.end())));
+  std::vector<int> expected_sizes;
+  for (auto r : srt::group_equals(input.begin(), input.end(), srt::less{}))
+    expected_sizes.push_back(static_cast<int>(r.end() - r.begin()));
+  REQUIRE(group_sizes == expected_sizes);
+
+  for (auto h = s.begin(); h != s.end(); ++h) {
+    for (int v = -1; v <= 21; ++v) {
+      REQUIRE(srt::lower_bound_hinted(s.begin(), h, s.end(), v) ==
+              s.lower_bound(v));
+      REQUIRE(srt::upper_bound_hinted(s.begin(), h, s.end(), v) ==
+              s.upper_bound(v));
+    }
+  }
+}
+
+TEST_CASE("skip_list_copy_and_compare", "[skip_list]") {
+  srt::skip_list<std::string, std::greater<>> s;
+  for (const char* x : {"b", "d", "a", "c", "b"}) s.insert(x);
+
+  auto copy = s;
+  auto moved = std::move(s);
+  REQUIRE(s.empty());
+
+  std::vector<std::string> expected{"d", "c", "b", "b", "a"};
+  REQUIRE(std::vector<std::string>(copy.begin(), copy.end()) == expected);
+  REQUIRE(std::vector<std::string>(moved.begin(), moved.end()) == expected);
+  REQUIRE(*copy.lower_bound("b") == "b");
+  REQUIRE(std::distance(copy.begin(), copy.upper_bound("b")) == 4);
+
+  s = copy;
+  REQUIRE(s.erase("b") == 2);
+  REQUIRE(s.size() == 3);
+  REQUIRE(copy.size() == 5);
+}
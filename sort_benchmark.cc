@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "result.h"
+
+namespace {
+
+constexpr std::size_t kSize = 1000000u;
+
+// Concatenation of `shards` sorted shards: kSize shards is random input.
+const std::vector<std::int64_t>& sharded_input(std::size_t shards) {
+  static std::vector<std::int64_t> res;
+  static std::size_t res_shards = 0;
+  if (res_shards == shards) return res;
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(0, 1000000000);
+  res.resize(kSize);
+  for (auto& x : res) x = dis(g);
+
+  std::size_t shard_size = kSize / shards;
+  for (auto f = res.begin(); f != res.end();) {
+    auto l = res.end() - f > static_cast<std::ptrdiff_t>(shard_size)
+                 ? f + static_cast<std::ptrdiff_t>(shard_size)
+                 : res.end();
+    std::sort(f, l);
+    f = l;
+  }
+
+  res_shards = shards;
+  return res;
+}
+
+void set_shards(benchmark::internal::Benchmark* bench) {
+  for (std::size_t shards : {1u, 4u, 16u, 64u, 256u, 4096u, 1000000u})
+    bench->Arg(static_cast<int>(shards));
+}
+
+struct std_sort {
+  template <typename I>
+  void operator()(I f, I l) {
+    std::sort(f, l);
+  }
+};
+
+struct std_stable_sort {
+  template <typename I>
+  void operator()(I f, I l) {
+    std::stable_sort(f, l);
+  }
+};
+
+struct adaptive_sort {
+  template <typename I>
+  void operator()(I f, I l) {
+    srt::sort_adaptive(f, l);
+  }
+};
+
+}  // namespace
+
+template <typename Alg>
+void benchmark_sort(benchmark::State& state) {
+  const auto& input = sharded_input(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::int64_t> buf;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    buf = input;
+    state.ResumeTiming();
+
+    Alg{}(buf.begin(), buf.end());
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK_TEMPLATE(benchmark_sort, std_sort)->Apply(set_shards);
+BENCHMARK_TEMPLATE(benchmark_sort, std_stable_sort)->Apply(set_shards);
+BENCHMARK_TEMPLATE(benchmark_sort, adaptive_sort)->Apply(set_shards);
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mmap_sorted_array.h"
+#include "result.h"
+
+namespace srt {
+
+// Two level layout for sorted files too large to keep in memory.
+//
+// The writer packs sorted fixed-width records into pages (no record
+// crosses a page), then appends the last key of every page and a
+// trailer. The reader keeps only those keys in memory. A lookup
+// searches them for the first page whose last key is not less than the
+// query, the answer is in that page, so one pread and a lower_bound_n
+// over it are enough: at most one I/O per lookup, none past the end.
+//
+// Batched lookups take sorted queries. They search the keys with
+// lower_bound_biased from the previous answer and read every page once,
+// however many queries land in it.
+//
+// File layout:
+//   pages       page_count * page_size bytes, the tail of a page is zeros
+//   last keys   page_count keys
+//   trailer     magic, page_size, size, page_count as uint64_t
+//
+// POSIX only. Errors from the system throw std::system_error, malformed
+// files std::runtime_error.
+
+namespace sparse_file_index_detail {
+
+constexpr std::uint64_t kMagic = 0x7370617273696478u;  // "sparsidx"
+constexpr std::size_t kDefaultPageSize = 4096;
+
+struct trailer {
+  std::uint64_t magic;
+  std::uint64_t page_size;
+  std::uint64_t size;
+  std::uint64_t page_count;
+};
+
+[[noreturn]] inline void throw_errno(const char* what,
+                                     const std::string& path) {
+  throw std::system_error(errno, std::generic_category(),
+                          std::string("sparse_file_index: ") + what + " " +
+                              path);
+}
+
+inline void write_all(int fd, const void* data, std::size_t n,
+                      const std::string& path) {
+  const char* p = static_cast<const char*>(data);
+  while (n != 0) {
+    ssize_t written = ::write(fd, p, n);
+    if (written == -1) {
+      if (errno == EINTR) continue;
+      throw_errno("write", path);
+    }
+    p += written;
+    n -= static_cast<std::size_t>(written);
+  }
+}
+
+// Returns false on errors and if the file ends before n bytes.
+inline bool read_all(int fd, void* data, std::size_t n, std::uint64_t offset) {
+  char* p = static_cast<char*>(data);
+  while (n != 0) {
+    ssize_t read = ::pread(fd, p, n, static_cast<off_t>(offset));
+    if (read == -1) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    if (read == 0) return false;
+    p += read;
+    n -= static_cast<std::size_t>(read);
+    offset += static_cast<std::uint64_t>(read);
+  }
+  return true;
+}
+
+}  // namespace sparse_file_index_detail
+
+template <typename Record, typename KeyFn = identity>
+class sparse_file_writer {
+  static_assert(std::is_trivially_copyable<Record>::value,
+                "records are written as they are in memory");
+
+ public:
+  using key_type = std::decay_t<decltype(
+      std::declval<KeyFn&>()(std::declval<const Record&>()))>;
+
+ private:
+  std::string path_;
+  int fd_ = -1;
+  KeyFn key_fn_;
+  std::vector<char> page_;
+  std::size_t records_per_page_;
+  std::size_t in_page_ = 0;
+  std::uint64_t size_ = 0;
+  std::vector<key_type> last_keys_;
+
+  void flush_page() {
+    using namespace sparse_file_index_detail;
+    std::memset(page_.data() + in_page_ * sizeof(Record), 0,
+                page_.size() - in_page_ * sizeof(Record));
+    write_all(fd_, page_.data(), page_.size(), path_);
+    Record last;
+    std::memcpy(&last, page_.data() + (in_page_ - 1) * sizeof(Record),
+                sizeof(Record));
+    last_keys_.push_back(key_fn_(last));
+    in_page_ = 0;
+  }
+
+ public:
+  // Truncates path.
+  explicit sparse_file_writer(
+      const std::string& path,
+      std::size_t page_size = sparse_file_index_detail::kDefaultPageSize,
+      KeyFn key_fn = KeyFn{})
+      : path_(path),
+        key_fn_(key_fn),
+        page_(page_size),
+        records_per_page_(page_size / sizeof(Record)) {
+    static_assert(std::is_trivially_copyable<key_type>::value,
+                  "keys are written as they are in memory");
+    if (records_per_page_ == 0)
+      throw std::invalid_argument("sparse_file_writer: page_size < record");
+    fd_ =
+        ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ == -1) sparse_file_index_detail::throw_errno("open", path);
+  }
+
+  sparse_file_writer(const sparse_file_writer&) = delete;
+  sparse_file_writer& operator=(const sparse_file_writer&) = delete;
+
+  // If finish() was not called, the file is left incomplete.
+  ~sparse_file_writer() {
+    if (fd_ != -1) ::close(fd_);
+  }
+
+  // Records go in sorted by key.
+  void push_back(const Record& r) {
+    std::memcpy(page_.data() + in_page_ * sizeof(Record), &r,
+                sizeof(Record));
+    ++size_;
+    if (++in_page_ == records_per_page_) flush_page();
+  }
+
+  // Writes the last page, the keys and the trailer.
+  void finish() {
+    using namespace sparse_file_index_detail;
+    if (in_page_ != 0) flush_page();
+    write_all(fd_, last_keys_.data(), last_keys_.size() * sizeof(key_type),
+              path_);
+    trailer t{kMagic, page_.size(), size_, last_keys_.size()};
+    write_all(fd_, &t, sizeof(t), path_);
+    if (::close(fd_) == -1) {
+      fd_ = -1;
+      throw_errno("close", path_);
+    }
+    fd_ = -1;
+  }
+};
+
+template <typename Record, typename KeyFn = identity>
+class sparse_file_index {
+  static_assert(std::is_trivially_copyable<Record>::value,
+                "records are read straight from the file");
+
+ public:
+  using key_type = std::decay_t<decltype(
+      std::declval<KeyFn&>()(std::declval<const Record&>()))>;
+  using key_compare = record_key_compare<Record, KeyFn>;
+
+  // rank == size() means there is no such record, then record is
+  // value initialized.
+  struct lookup {
+    std::size_t rank;
+    Record record;
+  };
+
+ private:
+  std::string path_;
+  int fd_ = -1;
+  KeyFn key_fn_;
+  std::size_t page_size_ = 0;
+  std::size_t records_per_page_ = 0;
+  std::size_t size_ = 0;
+  std::vector<key_type> last_keys_;
+  mutable std::atomic<std::size_t> page_reads_{0};
+
+  [[noreturn]] void throw_malformed() const {
+    throw std::runtime_error("sparse_file_index: cannot read " + path_ +
+                             " as a sparse_file_writer file");
+  }
+
+  std::size_t records_in_page(std::size_t page) const {
+    return std::min(records_per_page_, size_ - page * records_per_page_);
+  }
+
+  void read_page(std::size_t page, std::vector<Record>& buf) const {
+    buf.resize(records_in_page(page));
+    if (!sparse_file_index_detail::read_all(
+            fd_, buf.data(), buf.size() * sizeof(Record),
+            static_cast<std::uint64_t>(page) * page_size_))
+      throw_malformed();
+    page_reads_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  template <typename K>
+  lookup search_page(std::size_t page, const std::vector<Record>& buf,
+                     const K& k) const {
+    auto it = lower_bound_n(buf.begin(),
+                            static_cast<std::ptrdiff_t>(buf.size()), k,
+                            key_comp());
+    // The page was chosen by its last key, the answer is in it.
+    auto offset = static_cast<std::size_t>(it - buf.begin());
+    return {page * records_per_page_ + offset, *it};
+  }
+
+ public:
+  explicit sparse_file_index(const std::string& path, KeyFn key_fn = KeyFn{})
+      : path_(path), key_fn_(key_fn) {
+    using namespace sparse_file_index_detail;
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ == -1) throw_errno("open", path);
+
+    try {
+      struct stat st;
+      if (::fstat(fd_, &st) == -1) throw_errno("fstat", path);
+      auto bytes = static_cast<std::uint64_t>(st.st_size);
+
+      trailer t;
+      if (bytes < sizeof(t) ||
+          !read_all(fd_, &t, sizeof(t), bytes - sizeof(t)) ||
+          t.magic != kMagic || t.page_size < sizeof(Record) ||
+          t.page_count != (t.size + t.page_size / sizeof(Record) - 1) /
+                              (t.page_size / sizeof(Record)) ||
+          bytes != t.page_count * (t.page_size + sizeof(key_type)) + sizeof(t))
+        throw_malformed();
+
+      page_size_ = static_cast<std::size_t>(t.page_size);
+      records_per_page_ = page_size_ / sizeof(Record);
+      size_ = static_cast<std::size_t>(t.size);
+      last_keys_.resize(static_cast<std::size_t>(t.page_count));
+      if (!read_all(fd_, last_keys_.data(),
+                    last_keys_.size() * sizeof(key_type),
+                    t.page_count * t.page_size))
+        throw_malformed();
+    } catch (...) {
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  sparse_file_index(const sparse_file_index&) = delete;
+  sparse_file_index& operator=(const sparse_file_index&) = delete;
+
+  ~sparse_file_index() {
+    if (fd_ != -1) ::close(fd_);
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t page_count() const { return last_keys_.size(); }
+  std::size_t page_size() const { return page_size_; }
+
+  std::size_t memory_usage() const {
+    return sizeof(*this) + last_keys_.capacity() * sizeof(key_type);
+  }
+
+  // Instrumentation: how many pages were read since the last reset.
+  std::size_t page_reads() const {
+    return page_reads_.load(std::memory_order_relaxed);
+  }
+  void reset_page_reads() { page_reads_.store(0, std::memory_order_relaxed); }
+
+  key_compare key_comp() const { return key_compare(key_fn_); }
+
+  template <typename K>
+  // requires K is key_type or Record
+  lookup lower_bound(const K& k) const {
+    auto page = static_cast<std::size_t>(
+        lower_bound_n(last_keys_.begin(),
+                      static_cast<std::ptrdiff_t>(last_keys_.size()), k,
+                      key_comp()) -
+        last_keys_.begin());
+    if (page == last_keys_.size()) return {size_, Record{}};
+
+    std::vector<Record> buf;
+    read_page(page, buf);
+    return search_page(page, buf, k);
+  }
+
+  template <typename K>
+  // requires K is key_type or Record
+  bool contains(const K& k) const {
+    lookup res = lower_bound(k);
+    return res.rank != size_ && !key_comp()(k, res.record);
+  }
+
+  // [f, l) is sorted. Writes a lookup per query.
+  template <typename I, typename O>
+  // requires InputIterator<I> && OutputIterator<O, lookup> &&
+  //          ValueType<I> is key_type or Record
+  O lower_bound_batch(I f, I l, O out) const {
+    std::vector<Record> buf;
+    auto page_f = last_keys_.begin();
+    auto loaded = last_keys_.end();
+
+    for (; f != l; ++f, ++out) {
+      page_f = lower_bound_biased(page_f, last_keys_.end(), *f, key_comp());
+      if (page_f == last_keys_.end()) {
+        *out = lookup{size_, Record{}};
+        continue;
+      }
+      auto page = static_cast<std::size_t>(page_f - last_keys_.begin());
+      if (page_f != loaded) {
+        read_page(page, buf);
+        loaded = page_f;
+      }
+      *out = search_page(page, buf, *f);
+    }
+    return out;
+  }
+};
+
+}  // namespace srt
@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mmap_sorted_array.h"
+#include "sparse_file_index.h"
+
+namespace {
+
+// 256MB of 16 byte records.
+constexpr std::size_t kRecordsCount = 1u << 24;
+constexpr std::size_t kLookups = 1000;
+
+struct record {
+  std::int64_t key;
+  std::int64_t payload;
+};
+
+struct by_key {
+  std::int64_t operator()(const record& r) const { return r.key; }
+};
+
+record record_at(std::size_t i) {
+  return {static_cast<std::int64_t>(i) * 3, static_cast<std::int64_t>(i)};
+}
+
+// The same records, as a plain array and in the sparse layout.
+const std::string& plain_path() {
+  static const std::string path = [] {
+    std::string res = "/tmp/sparse_file_index_benchmark_plain.bin";
+    std::ofstream out(res, std::ios::binary);
+    for (std::size_t i = 0; i != kRecordsCount; ++i) {
+      record r = record_at(i);
+      out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+    }
+    return res;
+  }();
+  return path;
+}
+
+const std::string& sparse_path() {
+  static const std::string path = [] {
+    std::string res = "/tmp/sparse_file_index_benchmark_sparse.bin";
+    srt::sparse_file_writer<record, by_key> writer(res);
+    for (std::size_t i = 0; i != kRecordsCount; ++i)
+      writer.push_back(record_at(i));
+    writer.finish();
+    return res;
+  }();
+  return path;
+}
+
+// Drops a file from the page cache, the next access reads the disk.
+void evict_file(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+}
+
+long major_faults() {
+  rusage usage;
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_majflt;
+}
+
+std::vector<std::int64_t> queries(std::size_t count, bool sorted) {
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(0, kRecordsCount * 3);
+  std::vector<std::int64_t> res(count);
+  for (auto& x : res) x = dis(g);
+  if (sorted) std::sort(res.begin(), res.end());
+  return res;
+}
+
+void set_sorted(benchmark::internal::Benchmark* bench) {
+  for (int sorted : {0, 1}) bench->Arg(sorted);
+  bench->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+// kLookups lookups in a file that is not in the page cache, range(0):
+// sorted queries. io_per_lookup is major page faults for mmap, preads
+// for the sparse index.
+
+void benchmark_cold_mmap_binary_search(benchmark::State& state) {
+  const auto qs = queries(kLookups, state.range(0) != 0);
+  long faults = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    evict_file(plain_path());
+    state.ResumeTiming();
+
+    long faults_before = major_faults();
+    const srt::mmap_sorted_array<record, by_key> index(plain_path());
+    index.advise(decltype(index)::access::random);
+    for (auto q : qs) benchmark::DoNotOptimize(index.lower_bound(q));
+    faults += major_faults() - faults_before;
+  }
+  state.counters["io_per_lookup"] =
+      static_cast<double>(faults) /
+      static_cast<double>(state.iterations() * kLookups);
+}
+
+void benchmark_cold_sparse_index(benchmark::State& state) {
+  const auto qs = queries(kLookups, state.range(0) != 0);
+  srt::sparse_file_index<record, by_key> index(sparse_path());
+  std::size_t reads = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    evict_file(sparse_path());
+    index.reset_page_reads();
+    state.ResumeTiming();
+
+    for (auto q : qs) benchmark::DoNotOptimize(index.lower_bound(q));
+    reads += index.page_reads();
+  }
+  state.counters["io_per_lookup"] =
+      static_cast<double>(reads) /
+      static_cast<double>(state.iterations() * kLookups);
+}
+
+// range(0) sorted queries, the denser they are, the more share a page.
+void benchmark_cold_sparse_index_batch(benchmark::State& state) {
+  const auto lookups = static_cast<std::size_t>(state.range(0));
+  const auto qs = queries(lookups, true);
+  srt::sparse_file_index<record, by_key> index(sparse_path());
+  std::vector<srt::sparse_file_index<record, by_key>::lookup> res(lookups);
+  std::size_t reads = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    evict_file(sparse_path());
+    index.reset_page_reads();
+    state.ResumeTiming();
+
+    index.lower_bound_batch(qs.begin(), qs.end(), res.begin());
+    benchmark::DoNotOptimize(res.data());
+    reads += index.page_reads();
+  }
+  state.counters["io_per_lookup"] =
+      static_cast<double>(reads) /
+      static_cast<double>(state.iterations() * lookups);
+}
+
+BENCHMARK(benchmark_cold_mmap_binary_search)->Apply(set_sorted);
+BENCHMARK(benchmark_cold_sparse_index)->Apply(set_sorted);
+BENCHMARK(benchmark_cold_sparse_index_batch)
+    ->Arg(kLookups)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
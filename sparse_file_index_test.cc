@@ -0,0 +1,120 @@
+#include "sparse_file_index.h"
+#include "third_party/catch.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+struct record {
+  std::int64_t key;
+  std::int32_t payload;
+};
+
+struct by_key {
+  std::int64_t operator()(const record& r) const { return r.key; }
+};
+
+std::string temp_path() {
+  char path[] = "/tmp/sparse_file_index_testXXXXXX";
+  int fd = ::mkstemp(path);
+  REQUIRE(fd != -1);
+  ::close(fd);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("sparse_file_index", "[sparse_file_index]") {
+  std::mt19937 g;
+  const std::string path = temp_path();
+
+  // 4 and 2 records per page, and one record per page.
+  for (std::size_t page_size : {64, 32, 17}) {
+    for (std::size_t size : {0, 1, 2, 4, 5, 100, 1001}) {
+      std::uniform_int_distribution<std::int64_t> dis(0, size);
+      std::vector<record> records(size);
+      for (auto& r : records)
+        r = {dis(g), static_cast<std::int32_t>(dis(g))};
+      std::sort(records.begin(), records.end(),
+                [](const record& x, const record& y) { return x.key < y.key; });
+      std::vector<std::int64_t> keys;
+      for (const auto& r : records) keys.push_back(r.key);
+
+      srt::sparse_file_writer<record, by_key> writer(path, page_size);
+      for (const auto& r : records) writer.push_back(r);
+      writer.finish();
+
+      srt::sparse_file_index<record, by_key> index(path);
+      REQUIRE(index.size() == size);
+      std::size_t per_page = page_size / sizeof(record);
+      REQUIRE(index.page_count() == (size + per_page - 1) / per_page);
+
+      std::vector<std::int64_t> queries;
+      for (std::int64_t v = -1; v <= static_cast<std::int64_t>(size) + 1; ++v)
+        queries.push_back(v);
+
+      for (auto v : queries) {
+        auto lb = static_cast<std::size_t>(
+            std::lower_bound(keys.begin(), keys.end(), v) - keys.begin());
+        index.reset_page_reads();
+        auto res = index.lower_bound(v);
+        REQUIRE(res.rank == lb);
+        REQUIRE(index.page_reads() == (lb == size ? 0u : 1u));
+        if (lb != size) {
+          REQUIRE(res.record.key == records[lb].key);
+          REQUIRE(res.record.payload == records[lb].payload);
+        }
+        REQUIRE(index.contains(v) ==
+                std::binary_search(keys.begin(), keys.end(), v));
+      }
+
+      index.reset_page_reads();
+      std::vector<srt::sparse_file_index<record, by_key>::lookup> batch;
+      index.lower_bound_batch(queries.begin(), queries.end(),
+                              std::back_inserter(batch));
+      REQUIRE(batch.size() == queries.size());
+      // Sorted queries read every page at most once.
+      REQUIRE(index.page_reads() <= index.page_count());
+      for (std::size_t i = 0; i != queries.size(); ++i) {
+        auto lb = static_cast<std::size_t>(
+            std::lower_bound(keys.begin(), keys.end(), queries[i]) -
+            keys.begin());
+        REQUIRE(batch[i].rank == lb);
+        if (lb != size) REQUIRE(batch[i].record.key == records[lb].key);
+      }
+    }
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("sparse_file_index_errors", "[sparse_file_index]") {
+  using index = srt::sparse_file_index<std::int64_t>;
+  REQUIRE_THROWS_AS(index("/nonexistent/sparse_file_index"),
+                    std::system_error);
+
+  const std::string path = temp_path();
+  REQUIRE_THROWS_AS(index{path}, std::runtime_error);
+
+  {
+    srt::sparse_file_writer<std::int64_t> writer(path, 32);
+    for (std::int64_t i = 0; i != 10; ++i) writer.push_back(i);
+    writer.finish();
+  }
+  REQUIRE(index(path).lower_bound(std::int64_t{7}).rank == 7);
+  REQUIRE(::truncate(path.c_str(), 40) == 0);
+  REQUIRE_THROWS_AS(index{path}, std::runtime_error);
+
+  REQUIRE_THROWS_AS(srt::sparse_file_writer<std::int64_t>(path, 4),
+                    std::invalid_argument);
+  std::remove(path.c_str());
+}
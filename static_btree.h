@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+
+namespace srt {
+
+// A static B+ tree (S-tree) over sorted arithmetic keys. Every node is
+// one cache line of keys: 16 int32 or 8 int64. The leaves are the sorted
+// keys themselves, padded to whole nodes; key j of an internal node is
+// the smallest key under its child j + 1. So the child to go to is the
+// number of keys in the node that are before the needle, which is a few
+// simd compares and popcounts (simd_traits) with no branches.
+//
+// All nodes are in one array, root first and leaves last; searches
+// return pointers into the leaves, which [begin(), end()) exposes as a
+// sorted array.
+//
+// Nodes are padded with padding(): infinity for floating point, max()
+// otherwise. Keys equal to it are fine: the padding compares before the
+// needle only when every real key of the node does too, and counts are
+// clamped to the real keys of the node.
+
+template <typename T>
+class static_btree {
+  static_assert(std::is_arithmetic<T>::value,
+                "keys are padded with infinity() or max()");
+
+ public:
+  static constexpr std::size_t kCacheLine = 64;
+  static constexpr std::size_t kNodeSize =
+      sizeof(T) < kCacheLine ? kCacheLine / sizeof(T) : 1;
+
+ private:
+  static constexpr int kSimdWidth = simd_traits<T>::width;
+  using use_simd = std::integral_constant<bool, kSimdWidth != 0>;
+
+  struct layer {
+    std::size_t offset;  // index of the first node in nodes()
+    std::size_t size;    // in nodes
+  };
+
+  std::vector<T> storage_;
+  std::size_t aligned_offset_ = 0;  // in elements
+  std::vector<layer> layers_;       // leaves first
+  std::size_t size_ = 0;
+
+  const T* nodes() const { return storage_.data() + aligned_offset_; }
+  T* nodes() { return storage_.data() + aligned_offset_; }
+
+  const T* node(const layer& l, std::size_t i) const {
+    return nodes() + (l.offset + i) * kNodeSize;
+  }
+
+  static std::size_t count_less(const T* node, T v, std::true_type) {
+    static_assert(kNodeSize % kSimdWidth == 0, "");
+    unsigned res = 0;
+    for (std::size_t i = 0; i != kNodeSize; i += kSimdWidth)
+      res += static_cast<unsigned>(
+          __builtin_popcount(simd_traits<T>::less_mask(node + i, v)));
+    return res;
+  }
+
+  static std::size_t count_less(const T* node, T v, std::false_type) {
+    std::size_t res = 0;
+    for (std::size_t i = 0; i != kNodeSize; ++i) res += node[i] < v;
+    return res;
+  }
+
+  static std::size_t count_not_greater(const T* node, T v, std::true_type) {
+    unsigned res = kNodeSize;
+    for (std::size_t i = 0; i != kNodeSize; i += kSimdWidth)
+      res -= static_cast<unsigned>(
+          __builtin_popcount(simd_traits<T>::greater_mask(node + i, v)));
+    return res;
+  }
+
+  static std::size_t count_not_greater(const T* node, T v, std::false_type) {
+    std::size_t res = 0;
+    for (std::size_t i = 0; i != kNodeSize; ++i) res += !(v < node[i]);
+    return res;
+  }
+
+  static T padding() {
+    return std::numeric_limits<T>::has_infinity
+               ? std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::max();
+  }
+
+  // Count(node) - the number of keys in the node before the answer.
+  template <typename Count>
+  const T* search(Count count) const {
+    if (size_ == 0) return begin();
+
+    std::size_t i = 0;
+    for (std::size_t h = layers_.size() - 1; h != 0; --h) {
+      // A key for every child but the first, a count is at most
+      // kNodeSize anyway.
+      std::size_t keys = layers_[h - 1].size - i * (kNodeSize + 1) - 1;
+      std::size_t child = std::min(count(node(layers_[h], i)), keys);
+      i = i * (kNodeSize + 1) + child;
+    }
+
+    std::size_t keys = size_ - i * kNodeSize;
+    return begin() + i * kNodeSize + std::min(count(node(layers_[0], i)), keys);
+  }
+
+ public:
+  using value_type = T;
+  using const_iterator = const T*;
+
+  static_btree() = default;
+
+  // [f, l) is sorted.
+  template <typename I>
+  // requires ForwardIterator<I> && ValueType<I> == T
+  static_btree(I f, I l)
+      : size_(static_cast<std::size_t>(std::distance(f, l))) {
+    std::size_t total = 0;
+    std::size_t layer_size = (size_ + kNodeSize - 1) / kNodeSize;
+    while (true) {
+      layers_.push_back({0, layer_size});
+      total += layer_size;
+      if (layer_size <= 1) break;
+      layer_size = (layer_size + kNodeSize) / (kNodeSize + 1);
+    }
+    // Root first.
+    std::size_t offset = total;
+    for (auto& layer : layers_) {
+      offset -= layer.size;
+      layer.offset = offset;
+    }
+
+    allocate(total * kNodeSize);
+    std::fill(nodes(), nodes() + total * kNodeSize, padding());
+    std::copy(f, l, nodes() + layers_[0].offset * kNodeSize);
+
+    for (std::size_t h = 1; h < layers_.size(); ++h) {
+      T* keys = nodes() + layers_[h].offset * kNodeSize;
+      for (std::size_t i = 0; i != layers_[h].size; ++i) {
+        for (std::size_t j = 0; j != kNodeSize; ++j) {
+          std::size_t child = i * (kNodeSize + 1) + j + 1;
+          if (child < layers_[h - 1].size)
+            keys[i * kNodeSize + j] = min_key(h - 1, child);
+        }
+      }
+    }
+  }
+
+  static_btree(const static_btree& x) : layers_(x.layers_), size_(x.size_) {
+    std::size_t total = 0;
+    for (const auto& layer : layers_) total += layer.size;
+    allocate(total * kNodeSize);
+    std::copy(x.nodes(), x.nodes() + total * kNodeSize, nodes());
+  }
+
+  static_btree(static_btree&&) = default;
+
+  static_btree& operator=(static_btree x) {
+    storage_ = std::move(x.storage_);
+    aligned_offset_ = x.aligned_offset_;
+    layers_ = std::move(x.layers_);
+    size_ = x.size_;
+    return *this;
+  }
+
+  const_iterator begin() const {
+    return layers_.empty() ? nullptr
+                           : nodes() + layers_[0].offset * kNodeSize;
+  }
+  const_iterator end() const { return begin() + size_; }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t height() const { return layers_.size(); }
+
+  std::size_t memory_usage() const {
+    return sizeof(*this) + storage_.capacity() * sizeof(T) +
+           layers_.capacity() * sizeof(layer);
+  }
+
+  const_iterator lower_bound(T v) const {
+    return search([&](const T* n) { return count_less(n, v, use_simd{}); });
+  }
+
+  const_iterator upper_bound(T v) const {
+    return search(
+        [&](const T* n) { return count_not_greater(n, v, use_simd{}); });
+  }
+
+  range_pair<const_iterator> equal_range(T v) const {
+    return {lower_bound(v), upper_bound(v)};
+  }
+
+ private:
+  void allocate(std::size_t size) {
+    storage_.resize(size + kNodeSize + 1);
+    auto addr = reinterpret_cast<std::uintptr_t>(storage_.data());
+    aligned_offset_ = (kCacheLine - addr % kCacheLine) % kCacheLine / sizeof(T);
+  }
+
+  // The leftmost leaf key under node i of layer h.
+  T min_key(std::size_t h, std::size_t i) const {
+    for (; h != 0; --h) i *= kNodeSize + 1;
+    return node(layers_[0], i)[0];
+  }
+};
+
+}  // namespace srt
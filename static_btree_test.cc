@@ -0,0 +1,64 @@
+#include "static_btree.h"
+#include "third_party/catch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename T>
+void test_static_btree(std::size_t max_size) {
+  std::mt19937 g;
+
+  for (std::size_t size = 0; size < max_size; size += 1 + size / 8) {
+    std::uniform_int_distribution<int> dis(0, static_cast<int>(size));
+    std::vector<T> sorted(size);
+    for (T& x : sorted) x = static_cast<T>(dis(g));
+    // Real keys equal to the padding.
+    if (size % 3 == 0 && size != 0) sorted.back() = std::numeric_limits<T>::max();
+    if (size % 3 == 1 && std::numeric_limits<T>::has_infinity)
+      sorted.back() = std::numeric_limits<T>::infinity();
+    if (size % 5 == 2 && size > 1)
+      sorted[size - 2] = std::numeric_limits<T>::max();
+    std::sort(sorted.begin(), sorted.end());
+
+    srt::static_btree<T> tree(sorted.begin(), sorted.end());
+    srt::static_btree<T> copy = tree;
+    REQUIRE(std::vector<T>(tree.begin(), tree.end()) == sorted);
+
+    std::vector<T> needles{std::numeric_limits<T>::max(),
+                           std::numeric_limits<T>::lowest()};
+    if (std::numeric_limits<T>::has_infinity) {
+      needles.push_back(std::numeric_limits<T>::infinity());
+      needles.push_back(-std::numeric_limits<T>::infinity());
+    }
+    for (int v = -1; v <= static_cast<int>(size) + 1; ++v)
+      needles.push_back(static_cast<T>(v));
+
+    for (T v : needles) {
+      auto lb = std::lower_bound(sorted.begin(), sorted.end(), v) - sorted.begin();
+      auto ub = std::upper_bound(sorted.begin(), sorted.end(), v) - sorted.begin();
+
+      REQUIRE(tree.lower_bound(v) - tree.begin() == lb);
+      REQUIRE(tree.upper_bound(v) - tree.begin() == ub);
+      REQUIRE(copy.lower_bound(v) - copy.begin() == lb);
+
+      auto r = tree.equal_range(v);
+      REQUIRE(r.first - tree.begin() == lb);
+      REQUIRE(r.second - tree.begin() == ub);
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("static_btree", "[static_btree]") {
+  test_static_btree<std::int32_t>(5000);
+  test_static_btree<std::int64_t>(5000);
+  test_static_btree<std::uint16_t>(2000);
+  test_static_btree<float>(2000);
+  test_static_btree<double>(2000);
+}
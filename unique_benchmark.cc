@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "result.h"
+
+namespace {
+
+constexpr std::size_t kSize = 1000000u;
+
+// Sorted, runs of equal elements are run_length long on average.
+const std::vector<std::int64_t>& input_with_runs(std::size_t run_length) {
+  static std::vector<std::int64_t> res;
+  static std::size_t res_run_length = 0;
+  if (res_run_length == run_length) return res;
+
+  std::mt19937 g;
+  std::uniform_int_distribution<std::int64_t> dis(
+      0, static_cast<std::int64_t>(kSize / run_length));
+  res.resize(kSize);
+  for (auto& x : res) x = dis(g);
+  std::sort(res.begin(), res.end());
+
+  res_run_length = run_length;
+  return res;
+}
+
+void set_run_length(benchmark::internal::Benchmark* bench) {
+  for (std::size_t run_length = 1; run_length <= 100000; run_length *= 10)
+    bench->Arg(static_cast<int>(run_length));
+}
+
+struct std_unique {
+  template <typename I>
+  I operator()(I f, I l, std::size_t& comparisons) {
+    return std::unique(f, l, [&](const auto& x, const auto& y) {
+      ++comparisons;
+      return x == y;
+    });
+  }
+};
+
+struct biased_unique {
+  template <typename I>
+  I operator()(I f, I l, std::size_t& comparisons) {
+    return srt::unique_biased(f, l, [&](const auto& x, const auto& y) {
+      ++comparisons;
+      return x < y;
+    });
+  }
+};
+
+}  // namespace
+
+template <typename Alg>
+void benchmark_unique(benchmark::State& state) {
+  const auto& input = input_with_runs(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::int64_t> buf;
+  std::size_t comparisons = 0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    buf = input;
+    comparisons = 0;
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(Alg{}(buf.begin(), buf.end(), comparisons));
+  }
+
+  state.counters["comparisons"] = static_cast<double>(comparisons);
+}
+
+BENCHMARK_TEMPLATE(benchmark_unique, std_unique)->Apply(set_run_length);
+BENCHMARK_TEMPLATE(benchmark_unique, biased_unique)->Apply(set_run_length);